@@ -27,35 +27,3325 @@ THE SOFTWARE.
 #define __BASE_X__H_
 
 #include <cassert>          // for assert
-#include <algorithm>        // for std::find_if, std::reverse
-#include <stdexcept>        // for std::invalid_argument
+#include <algorithm>        // for std::find_if, std::fill_n
+#include <array>            // for std::array
+#include <atomic>           // for std::atomic
+#include <condition_variable> // for std::condition_variable
+#include <cstdint>          // for std::uint16_t, std::uint32_t
+#include <cstdlib>          // for std::getenv
+#include <cstring>          // for std::memchr, std::memcpy, std::memset
+#include <limits>           // for std::numeric_limits
+#include <deque>            // for std::deque
+#include <exception>        // for std::exception_ptr, std::rethrow_exception
+#include <functional>       // for std::function
+#include <memory>           // for std::unique_ptr
+#if __has_include(<memory_resource>)
+#include <memory_resource>  // for std::pmr::memory_resource, std::pmr::string
+#define BASE_X_PMR
+#endif
+#include <mutex>            // for std::mutex, std::lock_guard
+#include <stdexcept>        // for std::invalid_argument, std::out_of_range, std::length_error
 #include <string>           // for std::string
 #include <string_view>      // for std::string_view
+#include <system_error>     // for std::error_code, std::error_category
+#include <thread>           // for std::thread
 #include <type_traits>      // for std::enable_if_t
+#include <vector>           // for std::vector
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BASE_X_SIMD_X86
+#include <immintrin.h>      // for SSE4.1, AVX2 and AVX-512 intrinsics
+#endif
+
+#include "uinteger_t.hh"
+
+
+// Vector kernels for the power of two alphabets whose digits regroup whole
+// bytes: 4 bits (hex), 5 bits (base32) and 6 bits (base64). Encoders take
+// whole groups of input bytes, write the matching characters and return how
+// many bytes they consumed. Decoders take whole groups of characters, stop
+// before the first group holding anything but digits (padding, ignored and
+// invalid characters are left to the scalar loop, which reports them) and
+// return how many characters they consumed. Neither depends on a particular
+// alphabet: encoding looks digits up in the _chr table, and decoding
+// classifies characters with the digit ranges below. Each kernel is compiled
+// for its instruction set with a target attribute, and the entry points at the
+// bottom bind the best level the CPU supports at run time.
+namespace base_x_simd {
+
+// Runs of consecutive characters decoding to consecutive digits, read off the
+// _ord table. Alphabets needing more runs than fit are not vectorized (count
+// is zero).
+struct ranges {
+	int count;
+	unsigned char lo[8];
+	unsigned char len[8];
+	unsigned char delta[8];
+};
+
+#if defined(BASE_X_SIMD_X86)
+
+#define BASE_X_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define BASE_X_TARGET_AVX2 __attribute__((target("avx2")))
+#define BASE_X_TARGET_AVX512BW __attribute__((target("avx512f,avx512bw")))
+#define BASE_X_TARGET_AVX512VBMI __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+
+struct sse41_ranges {
+	int count;
+	__m128i lo[8];
+	__m128i last[8];
+	__m128i delta[8];
+
+	BASE_X_TARGET_SSE41 explicit sse41_ranges(const ranges& r) : count(r.count) {
+		for (int i = 0; i < count; ++i) {
+			lo[i] = _mm_set1_epi8(static_cast<char>(r.lo[i]));
+			last[i] = _mm_set1_epi8(static_cast<char>(r.len[i] - 1));
+			delta[i] = _mm_set1_epi8(static_cast<char>(r.delta[i]));
+		}
+	}
+};
+
+// Digit values of 16 characters; mask gets one bit per character that is a digit.
+BASE_X_TARGET_SSE41 inline __m128i sse41_classify(__m128i c, const sse41_ranges& r, int& mask) {
+	__m128i v = _mm_setzero_si128();
+	__m128i valid = _mm_setzero_si128();
+	for (int i = 0; i < r.count; ++i) {
+		__m128i t = _mm_sub_epi8(c, r.lo[i]);
+		__m128i m = _mm_cmpeq_epi8(_mm_min_epu8(t, r.last[i]), t);
+		v = _mm_or_si128(v, _mm_and_si128(m, _mm_add_epi8(c, r.delta[i])));
+		valid = _mm_or_si128(valid, m);
+	}
+	mask = _mm_movemask_epi8(valid);
+	return v;
+}
+
+// Characters for 16 digits below 16 * tables, from 16-entry slices of _chr.
+BASE_X_TARGET_SSE41 inline __m128i sse41_lookup(__m128i idx, const __m128i* table, int tables) {
+	__m128i r = _mm_shuffle_epi8(table[0], idx);
+	for (int i = 1; i < tables; ++i) {
+		r = _mm_blendv_epi8(r, _mm_shuffle_epi8(table[i], idx), _mm_cmpgt_epi8(idx, _mm_set1_epi8(static_cast<char>(i * 16 - 1))));
+	}
+	return r;
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_encode4(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chr));
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16, out += 32) {
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+		__m128i lo = _mm_and_si128(x, mask);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(table, _mm_unpacklo_epi8(hi, lo)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_shuffle_epi8(table, _mm_unpackhi_epi8(hi, lo)));
+	}
+	return i;
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_decode4(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const sse41_ranges r(rr);
+	const __m128i weights = _mm_set1_epi16(0x0110);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32, out += 16) {
+		int m0, m1;
+		__m128i a = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m0);
+		__m128i b = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), r, m1);
+		if ((m0 & m1) != 0xffff) break;
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+	}
+	return i;
+}
+
+// Base32 digit k of a 5-byte group straddles bytes 5k/8 and 5k/8 + 1; each
+// 16-bit lane takes that byte pair and shifts the digit down with mulhi.
+BASE_X_TARGET_SSE41 inline __m128i sse41_spread5(__m128i x, __m128i spread) {
+	const __m128i shifts = _mm_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8);
+	return _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(x, spread), shifts), _mm_set1_epi16(31));
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_encode5(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m128i table[2] = {
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr + 16)),
+	};
+	const __m128i spread0 = _mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4);
+	const __m128i spread1 = _mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, 10, 9);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 10, out += 16) {
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		__m128i idx = _mm_packus_epi16(sse41_spread5(x, spread0), sse41_spread5(x, spread1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), sse41_lookup(idx, table, 2));
+	}
+	return i;
+}
+
+// Folds 16 base32 digits into two 40-bit groups, one per 64-bit lane, and
+// returns their 10 bytes, most significant first.
+BASE_X_TARGET_SSE41 inline __m128i sse41_pack5(__m128i v) {
+	__m128i x = _mm_madd_epi16(_mm_maddubs_epi16(v, _mm_set1_epi16(0x0120)), _mm_set1_epi32(0x00010400));
+	x = _mm_or_si128(_mm_and_si128(_mm_slli_epi64(x, 20), _mm_set1_epi64x(0xffffffffff)), _mm_srli_epi64(x, 32));
+	return _mm_shuffle_epi8(x, _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1));
+}
+
+BASE_X_TARGET_SSE41 inline void sse41_store10(unsigned char* out, __m128i x) {
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(out), x);
+	auto tail = static_cast<std::uint16_t>(_mm_extract_epi16(x, 4));
+	std::memcpy(out + 8, &tail, 2);
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_decode5(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const sse41_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16, out += 10) {
+		int m;
+		__m128i v = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m);
+		if (m != 0xffff) break;
+		sse41_store10(out, sse41_pack5(v));
+	}
+	return i;
+}
+
+// Regroups 12 bytes into 16 six-bit digits, one 3-byte group per 32-bit lane.
+BASE_X_TARGET_SSE41 inline __m128i sse41_spread6(__m128i x) {
+	x = _mm_shuffle_epi8(x, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+	__m128i a = _mm_mulhi_epu16(_mm_and_si128(x, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+	__m128i b = _mm_mullo_epi16(_mm_and_si128(x, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+	return _mm_or_si128(a, b);
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_encode6(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m128i table[4] = {
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr + 16)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr + 32)),
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr + 48)),
+	};
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 12, out += 16) {
+		__m128i idx = sse41_spread6(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), sse41_lookup(idx, table, 4));
+	}
+	return i;
+}
+
+// Folds 16 base64 digits into four 24-bit groups and returns their 12 bytes,
+// most significant first.
+BASE_X_TARGET_SSE41 inline __m128i sse41_pack6(__m128i v) {
+	__m128i x = _mm_madd_epi16(_mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+	return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+BASE_X_TARGET_SSE41 inline void sse41_store12(unsigned char* out, __m128i x) {
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(out), x);
+	auto tail = static_cast<std::uint32_t>(_mm_extract_epi32(x, 2));
+	std::memcpy(out + 8, &tail, 4);
+}
+
+BASE_X_TARGET_SSE41 inline std::size_t sse41_decode6(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const sse41_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16, out += 12) {
+		int m;
+		__m128i v = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m);
+		if (m != 0xffff) break;
+		sse41_store12(out, sse41_pack6(v));
+	}
+	return i;
+}
+
+// Digit values of the leading digits of in, stopping at the first character
+// that is not one; out must have room for n bytes.
+BASE_X_TARGET_SSE41 inline std::size_t sse41_translate(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const sse41_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		int m;
+		__m128i v = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+		if (m != 0xffff) return i + __builtin_ctz(~m);
+	}
+	return i;
+}
+
+// Length of the run of leading digits of in.
+BASE_X_TARGET_SSE41 inline std::size_t sse41_validate(const char* in, std::size_t n, const ranges& rr) {
+	const sse41_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		int m;
+		sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m);
+		if (m != 0xffff) return i + __builtin_ctz(~m);
+	}
+	return i;
+}
+
+BASE_X_TARGET_SSE41 inline std::uint64_t sse41_sum(__m128i acc) {
+	alignas(16) std::uint64_t lanes[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+	return lanes[0] + lanes[1];
+}
+
+// Length of the run of leading digits of in, adding their digit values to
+// sum. psadbw against zero adds up each 8 digits into a 64-bit lane.
+BASE_X_TARGET_SSE41 inline std::size_t sse41_checksum(const char* in, std::size_t n, const ranges& rr, std::uint64_t& sum) {
+	const sse41_ranges r(rr);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = zero;
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		int m;
+		__m128i v = sse41_classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), r, m);
+		if (m != 0xffff) {
+			int k = __builtin_ctz(~m);
+			__m128i before = _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(k)), _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_and_si128(v, before), zero));
+			sum += sse41_sum(acc);
+			return i + k;
+		}
+		acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+	}
+	sum += sse41_sum(acc);
+	return i;
+}
+
+// The AVX2 kernels run the SSE4.1 lane logic on both 128-bit lanes and hand
+// what is left to the SSE4.1 kernels.
+
+struct avx2_ranges {
+	int count;
+	__m256i lo[8];
+	__m256i last[8];
+	__m256i delta[8];
+
+	BASE_X_TARGET_AVX2 explicit avx2_ranges(const ranges& r) : count(r.count) {
+		for (int i = 0; i < count; ++i) {
+			lo[i] = _mm256_set1_epi8(static_cast<char>(r.lo[i]));
+			last[i] = _mm256_set1_epi8(static_cast<char>(r.len[i] - 1));
+			delta[i] = _mm256_set1_epi8(static_cast<char>(r.delta[i]));
+		}
+	}
+};
+
+BASE_X_TARGET_AVX2 inline __m256i avx2_classify(__m256i c, const avx2_ranges& r, int& mask) {
+	__m256i v = _mm256_setzero_si256();
+	__m256i valid = _mm256_setzero_si256();
+	for (int i = 0; i < r.count; ++i) {
+		__m256i t = _mm256_sub_epi8(c, r.lo[i]);
+		__m256i m = _mm256_cmpeq_epi8(_mm256_min_epu8(t, r.last[i]), t);
+		v = _mm256_or_si256(v, _mm256_and_si256(m, _mm256_add_epi8(c, r.delta[i])));
+		valid = _mm256_or_si256(valid, m);
+	}
+	mask = _mm256_movemask_epi8(valid);
+	return v;
+}
+
+BASE_X_TARGET_AVX2 inline __m256i avx2_lookup(__m256i idx, const __m256i* table, int tables) {
+	__m256i r = _mm256_shuffle_epi8(table[0], idx);
+	for (int i = 1; i < tables; ++i) {
+		r = _mm256_blendv_epi8(r, _mm256_shuffle_epi8(table[i], idx), _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(static_cast<char>(i * 16 - 1))));
+	}
+	return r;
+}
+
+BASE_X_TARGET_AVX2 inline __m256i avx2_table(const char* chr) {
+	return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chr)));
+}
+
+// Two 16-byte loads, one per lane.
+BASE_X_TARGET_AVX2 inline __m256i avx2_load2(const void* lo, const void* hi) {
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo))), _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)), 1);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_encode4(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m256i table = avx2_table(chr);
+	const __m256i mask = _mm256_set1_epi8(0x0f);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32, out += 64) {
+		__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+		__m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), mask);
+		__m256i lo = _mm256_and_si256(x, mask);
+		__m256i a = _mm256_unpacklo_epi8(hi, lo);
+		__m256i b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(table, _mm256_permute2x128_si256(a, b, 0x20)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_shuffle_epi8(table, _mm256_permute2x128_si256(a, b, 0x31)));
+	}
+	return i + sse41_encode4(in + i, n - i, out, chr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_decode4(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const avx2_ranges r(rr);
+	const __m256i weights = _mm256_set1_epi16(0x0110);
+	std::size_t i = 0;
+	for (; i + 64 <= n; i += 64, out += 32) {
+		int m0, m1;
+		__m256i a = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m0);
+		__m256i b = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)), r, m1);
+		if ((m0 & m1) != -1) break;
+		__m256i x = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute4x64_epi64(x, 0xd8));
+	}
+	return i + sse41_decode4(in + i, n - i, out, rr);
+}
+
+BASE_X_TARGET_AVX2 inline __m256i avx2_spread5(__m256i x, __m256i spread) {
+	const __m256i shifts = _mm256_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8, 1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8);
+	return _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(x, spread), shifts), _mm256_set1_epi16(31));
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_encode5(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m256i table[2] = {avx2_table(chr), avx2_table(chr + 16)};
+	const __m256i spread0 = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4));
+	const __m256i spread1 = _mm256_broadcastsi128_si256(_mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, 10, 9));
+	std::size_t i = 0;
+	for (; i + 26 <= n; i += 20, out += 32) {
+		__m256i x = avx2_load2(in + i, in + i + 10);
+		__m256i idx = _mm256_packus_epi16(avx2_spread5(x, spread0), avx2_spread5(x, spread1));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), avx2_lookup(idx, table, 2));
+	}
+	return i + sse41_encode5(in + i, n - i, out, chr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_decode5(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const avx2_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32, out += 20) {
+		int m;
+		__m256i v = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m);
+		if (m != -1) break;
+		sse41_store10(out, sse41_pack5(_mm256_castsi256_si128(v)));
+		sse41_store10(out + 10, sse41_pack5(_mm256_extracti128_si256(v, 1)));
+	}
+	return i + sse41_decode5(in + i, n - i, out, rr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_encode6(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __m256i table[4] = {avx2_table(chr), avx2_table(chr + 16), avx2_table(chr + 32), avx2_table(chr + 48)};
+	const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+	std::size_t i = 0;
+	for (; i + 28 <= n; i += 24, out += 32) {
+		__m256i x = _mm256_shuffle_epi8(avx2_load2(in + i, in + i + 12), shuffle);
+		__m256i a = _mm256_mulhi_epu16(_mm256_and_si256(x, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+		__m256i b = _mm256_mullo_epi16(_mm256_and_si256(x, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), avx2_lookup(_mm256_or_si256(a, b), table, 4));
+	}
+	return i + sse41_encode6(in + i, n - i, out, chr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_decode6(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const avx2_ranges r(rr);
+	const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32, out += 24) {
+		int m;
+		__m256i v = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m);
+		if (m != -1) break;
+		__m256i x = _mm256_madd_epi16(_mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+		x = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, pack), compact);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(x));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(x, 1));
+	}
+	return i + sse41_decode6(in + i, n - i, out, rr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_translate(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	const avx2_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		int m;
+		__m256i v = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+		if (m != -1) return i + __builtin_ctz(~m);
+	}
+	return i + sse41_translate(in + i, n - i, out + i, rr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_validate(const char* in, std::size_t n, const ranges& rr) {
+	const avx2_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		int m;
+		avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m);
+		if (m != -1) return i + __builtin_ctz(~m);
+	}
+	return i + sse41_validate(in + i, n - i, rr);
+}
+
+BASE_X_TARGET_AVX2 inline std::size_t avx2_checksum(const char* in, std::size_t n, const ranges& rr, std::uint64_t& sum) {
+	const avx2_ranges r(rr);
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc = zero;
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		int m;
+		__m256i v = avx2_classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), r, m);
+		if (m != -1) {
+			int k = __builtin_ctz(~m);
+			__m256i before = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(k)), _mm256_setr_epi8(
+				0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31));
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_and_si256(v, before), zero));
+			sum += sse41_sum(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+			return i + k;
+		}
+		acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+	}
+	sum += sse41_sum(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+	return i + sse41_checksum(in + i, n - i, rr, sum);
+}
+
+// AVX-512BW classifies 64 characters per step straight into mask registers;
+// the 6-bit kernels below further need VBMI.
+
+struct avx512bw_ranges {
+	int count;
+	__m512i lo[8];
+	__m512i last[8];
+	__m512i delta[8];
+
+	BASE_X_TARGET_AVX512BW explicit avx512bw_ranges(const ranges& r) : count(r.count) {
+		for (int i = 0; i < count; ++i) {
+			lo[i] = _mm512_set1_epi8(static_cast<char>(r.lo[i]));
+			last[i] = _mm512_set1_epi8(static_cast<char>(r.len[i] - 1));
+			delta[i] = _mm512_set1_epi8(static_cast<char>(r.delta[i]));
+		}
+	}
+};
+
+BASE_X_TARGET_AVX512BW inline __m512i avx512bw_classify(__m512i c, const avx512bw_ranges& r, __mmask64& mask) {
+	__m512i v = _mm512_setzero_si512();
+	mask = 0;
+	for (int i = 0; i < r.count; ++i) {
+		__mmask64 m = _mm512_cmple_epu8_mask(_mm512_sub_epi8(c, r.lo[i]), r.last[i]);
+		v = _mm512_mask_add_epi8(v, m, c, r.delta[i]);
+		mask |= m;
+	}
+	return v;
+}
+
+BASE_X_TARGET_AVX512BW inline std::size_t avx512bw_validate(const char* in, std::size_t n, const ranges& rr) {
+	const avx512bw_ranges r(rr);
+	std::size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__mmask64 m;
+		avx512bw_classify(_mm512_loadu_si512(in + i), r, m);
+		if (~m) return i + __builtin_ctzll(~m);
+	}
+	return i + avx2_validate(in + i, n - i, rr);
+}
+
+BASE_X_TARGET_AVX512BW inline std::uint64_t avx512bw_sum(__m512i acc) {
+	// The maskz forms sidestep GCC 12 -Wmaybe-uninitialized noise in _mm512_reduce_add_epi64.
+	__m256i half = _mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xf, acc, 0), _mm512_maskz_extracti64x4_epi64(0xf, acc, 1));
+	return sse41_sum(_mm_add_epi64(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1)));
+}
+
+BASE_X_TARGET_AVX512BW inline std::size_t avx512bw_checksum(const char* in, std::size_t n, const ranges& rr, std::uint64_t& sum) {
+	const avx512bw_ranges r(rr);
+	const __m512i zero = _mm512_setzero_si512();
+	__m512i acc = zero;
+	std::size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		__mmask64 m;
+		__m512i v = avx512bw_classify(_mm512_loadu_si512(in + i), r, m);
+		if (~m) {
+			int k = __builtin_ctzll(~m);
+			acc = _mm512_add_epi64(acc, _mm512_sad_epu8(_mm512_maskz_mov_epi8((__mmask64(1) << k) - 1, v), zero));
+			sum += avx512bw_sum(acc);
+			return i + k;
+		}
+		acc = _mm512_add_epi64(acc, _mm512_sad_epu8(v, zero));
+	}
+	sum += avx512bw_sum(acc);
+	return i + avx2_checksum(in + i, n - i, rr, sum);
+}
+
+// Base64 with byte permutes: vpermb picks the bytes of each 3-byte group,
+// vpmultishiftqb cuts the digits and vpermb maps all 64 digits at once.
+BASE_X_TARGET_AVX512VBMI inline std::size_t avx512vbmi_encode6(const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	const __mmask64 all = ~__mmask64(0); // the maskz forms sidestep GCC 12 -Wmaybe-uninitialized noise
+	const __m512i table = _mm512_loadu_si512(chr);
+	const __m512i shuffle = _mm512_setr_epi32(
+		0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d, 0x10110f10, 0x13141213, 0x16171516,
+		0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122, 0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e);
+	const __m512i shifts = _mm512_set1_epi64(0x3036242a1016040a);
+	std::size_t i = 0;
+	for (; i + 64 <= n; i += 48, out += 64) {
+		__m512i x = _mm512_maskz_permutexvar_epi8(all, shuffle, _mm512_loadu_si512(in + i));
+		_mm512_storeu_si512(out, _mm512_maskz_permutexvar_epi8(all, _mm512_maskz_multishift_epi64_epi8(all, shifts, x), table));
+	}
+	return i + avx2_encode6(in + i, n - i, out, chr);
+}
+
+BASE_X_TARGET_AVX512VBMI inline std::size_t avx512vbmi_decode6(const char* in, std::size_t n, unsigned char* out, const ranges& rr) {
+	if (n < 256) {
+		return avx2_decode6(in, n, out, rr);
+	}
+	// 128-entry table for vpermi2b: the digit, or 0x80 for non-digits.
+	alignas(64) unsigned char lookup[128];
+	std::memset(lookup, 0x80, sizeof(lookup));
+	for (int i = 0; i < rr.count; ++i) {
+		for (int c = rr.lo[i]; c < rr.lo[i] + rr.len[i]; ++c) {
+			if (c < 128) {
+				lookup[c] = static_cast<unsigned char>(c + rr.delta[i]);
+			}
+		}
+	}
+	const __mmask64 all = ~__mmask64(0);
+	const __m512i lookup0 = _mm512_load_si512(lookup);
+	const __m512i lookup1 = _mm512_load_si512(lookup + 64);
+	const __m512i pack = _mm512_setr_epi32(
+		0x06000102, 0x090a0405, 0x0c0d0e08, 0x16101112, 0x191a1415, 0x1c1d1e18, 0x26202122, 0x292a2425,
+		0x2c2d2e28, 0x36303132, 0x393a3435, 0x3c3d3e38, 0, 0, 0, 0);
+	std::size_t i = 0;
+	for (; i + 64 <= n; i += 64, out += 48) {
+		__m512i c = _mm512_loadu_si512(in + i);
+		__m512i v = _mm512_permutex2var_epi8(lookup0, c, lookup1);
+		if (_mm512_movepi8_mask(_mm512_or_si512(v, c))) break;
+		__m512i x = _mm512_madd_epi16(_mm512_maddubs_epi16(v, _mm512_set1_epi32(0x01400140)), _mm512_set1_epi32(0x00011000));
+		_mm512_mask_storeu_epi8(out, 0xffffffffffffULL, _mm512_maskz_permutexvar_epi8(all, pack, x));
+	}
+	return i + avx2_decode6(in + i, n - i, out, rr);
+}
+
+#undef BASE_X_TARGET_SSE41
+#undef BASE_X_TARGET_AVX2
+#undef BASE_X_TARGET_AVX512BW
+#undef BASE_X_TARGET_AVX512VBMI
+
+#endif
+
+// Instruction set levels, each including the ones before it.
+enum class level {
+	scalar,
+	sse41,
+	avx2,
+	avx512vbmi,
+};
+
+// The kernels of one level; a null entry means the scalar loops do the work.
+struct kernels {
+	std::size_t (*encode[3])(const unsigned char* in, std::size_t n, char* out, const char* chr); // 4, 5 and 6 bits
+	std::size_t (*decode[3])(const char* in, std::size_t n, unsigned char* out, const ranges& r);
+	std::size_t (*translate)(const char* in, std::size_t n, unsigned char* out, const ranges& r);
+	std::size_t (*validate)(const char* in, std::size_t n, const ranges& r);
+	std::size_t (*checksum)(const char* in, std::size_t n, const ranges& r, std::uint64_t& sum);
+};
+
+inline const kernels& table(level l) {
+	static const kernels tables[] = {
+		{{nullptr, nullptr, nullptr}, {nullptr, nullptr, nullptr}, nullptr, nullptr, nullptr},
+#if defined(BASE_X_SIMD_X86)
+		{{sse41_encode4, sse41_encode5, sse41_encode6}, {sse41_decode4, sse41_decode5, sse41_decode6}, sse41_translate, sse41_validate, sse41_checksum},
+		{{avx2_encode4, avx2_encode5, avx2_encode6}, {avx2_decode4, avx2_decode5, avx2_decode6}, avx2_translate, avx2_validate, avx2_checksum},
+		{{avx2_encode4, avx2_encode5, avx512vbmi_encode6}, {avx2_decode4, avx2_decode5, avx512vbmi_decode6}, avx2_translate, avx512bw_validate, avx512bw_checksum},
+#endif
+	};
+	return tables[static_cast<int>(l)];
+}
+
+// The best level this CPU runs, probed once.
+inline level supported() {
+	static const level best = [] {
+#if defined(BASE_X_SIMD_X86)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw")) return level::avx512vbmi;
+		if (__builtin_cpu_supports("avx2")) return level::avx2;
+		if (__builtin_cpu_supports("sse4.1")) return level::sse41;
+#endif
+		return level::scalar;
+	}();
+	return best;
+}
+
+// Level l capped by a BASE_X_SIMD value: scalar, sse4.1, avx2 or avx512vbmi.
+// Any other name caps at scalar, so a typo never runs more than was asked
+// for; an unset or empty one leaves l alone.
+inline level capped(level l, const char* env) {
+	if (!env || !*env) return l;
+	std::string_view name(env);
+	level cap = name == "avx512vbmi" ? level::avx512vbmi : name == "avx2" ? level::avx2 : name == "sse4.1" ? level::sse41 : level::scalar;
+	return std::min(l, cap);
+}
+
+inline std::atomic<level>& current() {
+	// The BASE_X_SIMD environment variable caps the level picked at startup.
+	static std::atomic<level> active(capped(supported(), std::getenv("BASE_X_SIMD")));
+	return active;
+}
+
+// Forces the kernels of level l, or of the best supported level below it, and
+// returns the level bound. Meant for benchmarks and reproducing problems.
+inline level set_level(level l) {
+	l = std::min(l, supported());
+	current().store(l, std::memory_order_relaxed);
+	return l;
+}
+
+inline level get_level() {
+	return current().load(std::memory_order_relaxed);
+}
+
+inline std::size_t encode(unsigned bits, const unsigned char* in, std::size_t n, char* out, const char* chr) {
+	if (n < 16 || bits - 4 > 2) return 0;
+	auto f = table(get_level()).encode[bits - 4];
+	return f ? f(in, n, out, chr) : 0;
+}
+
+inline std::size_t decode(unsigned bits, const char* in, std::size_t n, unsigned char* out, const ranges& r) {
+	if (n < 16 || bits - 4 > 2 || !r.count) return 0;
+	auto f = table(get_level()).decode[bits - 4];
+	return f ? f(in, n, out, r) : 0;
+}
+
+inline std::size_t translate(const char* in, std::size_t n, unsigned char* out, const ranges& r) {
+	if (n < 16 || !r.count) return 0;
+	auto f = table(get_level()).translate;
+	return f ? f(in, n, out, r) : 0;
+}
+
+inline std::size_t validate(const char* in, std::size_t n, const ranges& r) {
+	if (n < 16 || !r.count) return 0;
+	auto f = table(get_level()).validate;
+	return f ? f(in, n, r) : 0;
+}
+
+// validate(), also adding the digit values of the run to sum.
+inline std::size_t checksum(const char* in, std::size_t n, const ranges& r, std::uint64_t& sum) {
+	if (n < 16 || !r.count) return 0;
+	auto f = table(get_level()).checksum;
+	return f ? f(in, n, r, sum) : 0;
+}
+
+} // namespace base_x_simd
+
+
+class BaseX {
+public:
+	// Why a decode failed, for try_decode() and the std::error_code decode().
+	enum class errc {
+		invalid_character = 1,
+		invalid_check,
+		invalid_checksum,
+		out_of_range,
+	};
+
+	// The outcome of try_decode(): no error, or its kind and the offset of
+	// the offending character (0 for out_of_range).
+	struct status {
+		errc code;
+		std::size_t offset;
+
+		constexpr bool ok() const noexcept {
+			return code == errc{};
+		}
+
+		constexpr explicit operator bool() const noexcept {
+			return ok();
+		}
+	};
+
+	// A pool of threads for the parallel encode. run() hands out tasks that
+	// the pool's threads and the calling thread work through together: each
+	// thread keeps a deque of tasks, takes its newest first and steals the
+	// oldest of another's when it runs dry. A thread waiting in run() keeps
+	// taking tasks, so runs can nest.
+	class workers {
+		struct queue {
+			std::mutex mtx;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		struct member {
+			const workers* pool;
+			std::size_t index;
+		};
+
+		// Thread i of the pool owns queues[i]; outside threads share the last.
+		const std::size_t count;
+		std::unique_ptr<queue[]> queues;
+		std::vector<std::thread> threads;
+		std::atomic<std::size_t> queued;
+		std::mutex mtx;
+		std::condition_variable wake;
+		bool stop;
+
+		static member& self() {
+			static thread_local member m{nullptr, 0};
+			return m;
+		}
+
+		std::size_t index() const {
+			return self().pool == this ? self().index : count - 1;
+		}
+
+		void push(std::size_t i, std::function<void()> task) {
+			{
+				std::lock_guard<std::mutex> lk(queues[i].mtx);
+				queues[i].tasks.push_back(std::move(task));
+			}
+			queued.fetch_add(1);
+			{
+				std::lock_guard<std::mutex> lk(mtx);
+			}
+			wake.notify_one();
+		}
+
+		bool take(std::size_t i, std::function<void()>& task) {
+			for (std::size_t j = 0; j < count; ++j) {
+				auto& q = queues[(i + j) % count];
+				std::lock_guard<std::mutex> lk(q.mtx);
+				if (!q.tasks.empty()) {
+					if (j) {
+						task = std::move(q.tasks.front());
+						q.tasks.pop_front();
+					} else {
+						task = std::move(q.tasks.back());
+						q.tasks.pop_back();
+					}
+					queued.fetch_sub(1);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void work(std::size_t i) {
+			self() = {this, i};
+			std::function<void()> task;
+			for (;;) {
+				if (take(i, task)) {
+					task();
+					continue;
+				}
+				std::unique_lock<std::mutex> lk(mtx);
+				wake.wait(lk, [this] { return stop || queued.load() != 0; });
+				if (stop) {
+					return;
+				}
+			}
+		}
+
+	public:
+		// threads counts the calling thread, which does its share while it
+		// waits in run(); with 0 or 1 it does all the work.
+		explicit workers(std::size_t threads_ = std::thread::hardware_concurrency()) :
+			count(threads_ > 1 ? threads_ : 1),
+			queues(new queue[count]),
+			queued(0),
+			stop(false)
+		{
+			for (std::size_t i = 0; i + 1 < count; ++i) {
+				threads.emplace_back(&workers::work, this, i);
+			}
+		}
+
+		workers(const workers&) = delete;
+		workers& operator=(const workers&) = delete;
+
+		~workers() {
+			{
+				std::lock_guard<std::mutex> lk(mtx);
+				stop = true;
+			}
+			wake.notify_all();
+			for (auto& t : threads) {
+				t.join();
+			}
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		// Calls f(0) to f(n - 1) in parallel and returns once all are done,
+		// rethrowing the first exception any of them threw.
+		template <typename F>
+		void run(std::size_t n, F&& f) {
+			std::atomic<std::size_t> pending(n);
+			std::exception_ptr error;
+			std::mutex error_mtx;
+			auto call = [&](std::size_t i) {
+				try {
+					f(i);
+				} catch (...) {
+					std::lock_guard<std::mutex> lk(error_mtx);
+					if (!error) {
+						error = std::current_exception();
+					}
+				}
+				// Once pending drops to zero run() may return, so nothing of
+				// this frame is touched after the decrement but the pool.
+				auto pool = this;
+				if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					{
+						std::lock_guard<std::mutex> lk(pool->mtx);
+					}
+					pool->wake.notify_all();
+				}
+			};
+			auto i = index();
+			for (auto j = n; j > 1; --j) {
+				push(i, [&call, j] { call(j - 1); });
+			}
+			if (n) {
+				call(0);
+			}
+			// Work through tasks until ours are done, sleeping while there is
+			// nothing to take.
+			std::function<void()> task;
+			while (pending.load(std::memory_order_acquire)) {
+				if (take(i, task)) {
+					task();
+					continue;
+				}
+				std::unique_lock<std::mutex> lk(mtx);
+				wake.wait(lk, [&] { return !pending.load(std::memory_order_acquire) || queued.load() != 0; });
+			}
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+	};
+
+	// What decode_bulk() gives, in input order: token i decodes to
+	// bytes[offsets[i], offsets[i + 1]), empty when errors[i] holds its
+	// failure (offsets in errors count from the token's start).
+	struct bulk {
+		std::string bytes;
+		std::vector<std::size_t> offsets;
+		std::vector<status> errors;
+	};
+
+	// How a call got its result: by blocks on block padding alphabets, by
+	// packed bits on the other power-of-two ones, and otherwise on a native
+	// word, on fixed-width words or by the long division of uinteger_t.
+	enum class path {
+		blocks,
+		packed,
+		native,
+		fixed,
+		division,
+	};
+
+#if defined(BASE_X_INSTRUMENT)
+	// What a BaseX did so far, when built with BASE_X_INSTRUMENT defined
+	// before including this header. Without it the counting compiles away.
+	// bytes_in counts the binary bytes encoded and the characters decoded
+	// or validated; bytes_out the characters and bytes of the results, with
+	// integers decoded counting the size of their type.
+	struct counters {
+		std::uint64_t encodes;
+		std::uint64_t decodes;
+		std::uint64_t validations;
+		std::uint64_t bytes_in;
+		std::uint64_t bytes_out;
+		std::uint64_t paths[5];     // encodes and decodes, by path
+		std::uint64_t failures[5];  // failed decodes and validations, by errc
+		std::uint64_t exceptions;   // decode failures thrown
+	};
+
+	struct usage {
+		const BaseX* codec;
+		counters counts;
+	};
+
+	// The counters of every BaseX used so far, summed over all threads,
+	// those that have exited included, in no particular order. Every thread
+	// counts into its own slots without locks, so a snapshot taken while
+	// others are busy may miss their latest calls.
+	static std::vector<usage> snapshot() {
+		auto& all = instruments::registry();
+		std::lock_guard<std::mutex> lk(all.mtx);
+		auto totals = all.retired;
+		for (auto block : all.live) {
+			block->collect(totals);
+		}
+		return totals;
+	}
+#endif
+
+private:
+	char _chr[256];
+	int _ord[256];
+	base_x_simd::ranges _ranges;
+
+	const int size;
+	const int alphabet_base;
+	const unsigned base_size;
+	const unsigned alphabet_base_bits;
+	const unsigned block_size;
+	const uinteger_t::digit alphabet_base_mask;
+	const unsigned word_digits;
+	const uinteger_t::digit word_base;
+	const unsigned word_shift;
+	const uinteger_t::digit word_inverse;
+	const unsigned base_shift;
+	const uinteger_t::digit base_inverse;
+	const unsigned half_digits;
+	const uinteger_t::digit half_base;
+	const unsigned half_shift;
+	const uinteger_t::digit half_inverse;
+	const uinteger_t::digit small_inverse;
+	const unsigned padding_size;
+	const char padding;
+	const int flags;
+
+	// The native word and fixed-width paths, built for this alphabet's
+	// constants by BasicBaseX or running on the members above.
+	struct codec;
+	const codec* _codec;
+
+	// The character pairs of every two digits, for power of two alphabets of
+	// up to 6 bits that BasicBaseX built them for, or null.
+	const char* _digrams;
+
+	template <typename Alphabet, int Flags>
+	friend class BasicBaseX;
+
+	template <int Size, int Base, int Flags, char Padding>
+	struct constants;
+
+	template <unsigned Bits>
+	struct digrams;
+
+	// The parameters a kernel runs on: the constants of K, or the members of
+	// *this when K is BaseX itself.
+	template <typename K>
+	constexpr decltype(auto) params() const {
+		if constexpr (std::is_same<K, BaseX>::value) {
+			return (*this);
+		} else {
+			return K{};
+		}
+	}
+
+	constexpr char chr(unsigned char ord) const {
+		return _chr[ord];
+	}
+
+	constexpr int ord(unsigned char chr) const {
+		return _ord[chr];
+	}
+
+#ifdef __SIZEOF_INT128__
+	__extension__ typedef unsigned __int128 double_digit;
+#endif
+
+#if defined(BASE_X_PMR)
+	typedef std::pmr::memory_resource memory_resource;
+#else
+	struct memory_resource;
+#endif
+
+	// Little-endian limbs of a value, copied once so long division can run on
+	// them in place. Short values live on the stack; longer ones take a single
+	// block, from memory when there is one and from the heap otherwise.
+	class scratch {
+		static constexpr std::size_t stack_size = 64;
+
+		uinteger_t::digit _stack[stack_size];
+		memory_resource* _memory;
+		std::size_t _capacity;
+		uinteger_t::digit* _data;
+		std::size_t _size;
+
+		void allocate(std::size_t capacity) {
+			_data = _stack;
+			_capacity = capacity;
+			if (capacity <= stack_size) {
+				return;
+			}
+#if defined(BASE_X_PMR)
+			if (_memory) {
+				_data = static_cast<uinteger_t::digit*>(_memory->allocate(capacity * sizeof(uinteger_t::digit), alignof(uinteger_t::digit)));
+				return;
+			}
+#endif
+			_data = new uinteger_t::digit[capacity];
+		}
+
+	public:
+		// Empty buffer with room for capacity limbs, to be filled through data().
+		explicit scratch(std::size_t capacity, memory_resource* memory = nullptr) : _memory(memory), _size(0) {
+			allocate(capacity);
+		}
+
+		// One spare limb is kept for the block padding shift.
+		scratch(const uinteger_t::digit* words, std::size_t words_size, memory_resource* memory = nullptr) : _memory(memory), _size(words_size) {
+			allocate(words_size + 1);
+			if (words_size) {
+				std::memcpy(_data, words, words_size * sizeof(uinteger_t::digit));
+			}
+			trim();
+		}
+
+		// Loads big-endian bytes.
+		scratch(const unsigned char* bytes, std::size_t bytes_size, memory_resource* memory = nullptr) : _memory(memory), _size((bytes_size + sizeof(uinteger_t::digit) - 1) / sizeof(uinteger_t::digit)) {
+			allocate(_size + 1);
+			auto end = bytes + bytes_size;
+			for (std::size_t i = 0; i < _size; ++i) {
+				uinteger_t::digit v = 0;
+				auto begin = end - std::min<std::size_t>(end - bytes, sizeof(uinteger_t::digit));
+				for (auto p = begin; p != end; ++p) {
+					v = (v << 8) | *p;
+				}
+				_data[i] = v;
+				end = begin;
+			}
+			trim();
+		}
+
+		// Whether a buffer of capacity limbs lives on the stack.
+		static constexpr bool fits(std::size_t capacity) {
+			return capacity <= stack_size;
+		}
+
+		~scratch() {
+			if (_data == _stack) {
+				return;
+			}
+#if defined(BASE_X_PMR)
+			if (_memory) {
+				_memory->deallocate(_data, _capacity * sizeof(uinteger_t::digit), alignof(uinteger_t::digit));
+				return;
+			}
+#endif
+			delete[] _data;
+		}
+
+		scratch(const scratch&) = delete;
+		scratch& operator=(const scratch&) = delete;
+
+		uinteger_t::digit* data() {
+			return _data;
+		}
+
+		const uinteger_t::digit* data() const {
+			return _data;
+		}
+
+		std::size_t size() const {
+			return _size;
+		}
+
+		void resize(std::size_t size) {
+			_size = size;
+			trim();
+		}
+
+		void trim() {
+			while (_size && !_data[_size - 1]) {
+				--_size;
+			}
+		}
+
+		std::size_t bits() const {
+			return _size ? _size * uinteger_t::digit_bits - leading_zeros(_data[_size - 1]) : 0;
+		}
+
+		// Shift left by fewer than digit_bits bits, growing into the spare limb.
+		void shift_left(std::size_t n) {
+			if (n && _size) {
+				uinteger_t::digit carry = 0;
+				for (std::size_t i = 0; i < _size; ++i) {
+					auto v = _data[i];
+					_data[i] = (v << n) | carry;
+					carry = v >> (uinteger_t::digit_bits - n);
+				}
+				if (carry) {
+					_data[_size++] = carry;
+				}
+			}
+		}
+
+		// Shift right by fewer than digit_bits bits.
+		void shift_right(std::size_t n) {
+			if (n && _size) {
+				for (std::size_t i = 0; i < _size - 1; ++i) {
+					_data[i] = (_data[i] >> n) | (_data[i + 1] << (uinteger_t::digit_bits - n));
+				}
+				_data[_size - 1] >>= n;
+				trim();
+			}
+		}
+
+		// Remainder of the division by a small divisor.
+		int mod(int divisor) const {
+			uinteger_t::digit r = 0;
+			for (auto i = _size; i; --i) {
+				auto v = _data[i - 1];
+				r = ((r << uinteger_t::half_digit_bits) | (v >> uinteger_t::half_digit_bits)) % divisor;
+				r = ((r << uinteger_t::half_digit_bits) | (v & ~uinteger_t::half_digit(0))) % divisor;
+			}
+			return static_cast<int>(r);
+		}
+
+		uinteger_t value() const {
+			std::string bytes;
+			bytes.reserve(_size * sizeof(uinteger_t::digit));
+			for (auto i = _size; i; --i) {
+				auto v = _data[i - 1];
+				for (auto b = uinteger_t::digit_bits; b; b -= 8) {
+					bytes.push_back(static_cast<char>(v >> (b - 8)));
+				}
+			}
+			return uinteger_t(bytes.data(), bytes.size(), 256);
+		}
+	};
+
+	// A caller's buffer used as a Result: it grows up to its capacity and
+	// throws std::length_error past it.
+	template <typename T>
+	class span {
+		T* _data;
+		std::size_t _size;
+		std::size_t _capacity;
+
+	public:
+		span(T* data, std::size_t capacity) : _data(data), _size(0), _capacity(capacity) { }
+
+		[[noreturn]] static void overflow() {
+			throw std::length_error("Error: Buffer too small");
+		}
+
+		T* data() {
+			return _data;
+		}
+
+		std::size_t size() const {
+			return _size;
+		}
+
+		std::size_t capacity() const {
+			return _capacity;
+		}
+
+		T& operator[](std::size_t i) {
+			return _data[i];
+		}
+
+		T* begin() {
+			return _data;
+		}
+
+		T* end() {
+			return _data + _size;
+		}
+
+		void clear() {
+			_size = 0;
+		}
+
+		void resize(std::size_t size) {
+			if (size > _capacity) overflow();
+			_size = size;
+		}
+
+		void resize(std::size_t size, T c) {
+			if (size > _capacity) overflow();
+			for (; _size < size; ++_size) {
+				_data[_size] = c;
+			}
+			_size = size;
+		}
+
+		void push_back(T c) {
+			if (_size == _capacity) overflow();
+			_data[_size++] = c;
+		}
+
+		template <typename It>
+		void append(It first, It last) {
+			if (static_cast<std::size_t>(last - first) > _capacity - _size) overflow();
+			for (; first != last; ++first) {
+				_data[_size++] = static_cast<T>(*first);
+			}
+		}
+
+		template <typename It>
+		void assign(It first, It last) {
+			_size = 0;
+			append(first, last);
+		}
+	};
+
+	template <typename Result>
+	struct is_span : std::false_type { };
+
+	template <typename T>
+	struct is_span<span<T>> : std::true_type { };
+
+	// Digits come out least significant first; this writes them back to front
+	// so they land in order with no reverse pass.
+	struct reverse_writer {
+		char* first;
+		char* ptr;
+
+		void push_back(char c) {
+			if (ptr == first) span<char>::overflow();
+			*--ptr = c;
+		}
+
+		// Puts both characters of a pair in front, in the pair's order.
+		void push_pair(const char* pair) {
+			if (ptr - first < 2) span<char>::overflow();
+			ptr -= 2;
+			std::memcpy(ptr, pair, 2);
+		}
+	};
+
+	// Grows result by up to n elements for encode_num to write into and
+	// returns how many it added: n for growable results, whatever is left
+	// for a span.
+	template <typename Result>
+	static std::size_t make_room(Result& result, std::size_t n) {
+		result.resize(result.size() + n);
+		return n;
+	}
+
+	template <typename T>
+	static std::size_t make_room(span<T>& result, std::size_t) {
+		auto n = result.capacity() - result.size();
+		result.resize(result.capacity());
+		return n;
+	}
+
+	// The memory resource of a std::pmr result, which its scratch limbs
+	// come from too; null for every other result.
+	template <typename Result>
+	static memory_resource* memory_of(const Result&) {
+		return nullptr;
+	}
+
+#if defined(BASE_X_PMR)
+	template <typename T>
+	static memory_resource* memory_of(const std::pmr::basic_string<T>& result) {
+		return result.get_allocator().resource();
+	}
+
+	template <typename T>
+	static memory_resource* memory_of(const std::pmr::vector<T>& result) {
+		return result.get_allocator().resource();
+	}
+#endif
+
+	static constexpr unsigned leading_zeros(uinteger_t::digit v) {
+		unsigned n = uinteger_t::digit_bits;
+		for (unsigned s = uinteger_t::digit_bits / 2; s; s /= 2) {
+			if (v >> s) {
+				v >>= s;
+				n -= s;
+			}
+		}
+		return n - (v != 0);
+	}
+
+	// Number of base digits that always fit in one word_base divisor: a full
+	// digit when double-digit arithmetic is available, a half digit otherwise.
+	static constexpr unsigned digits_per_word(int base) {
+#ifdef __SIZEOF_INT128__
+		constexpr uinteger_t::digit max = ~uinteger_t::digit(0);
+#else
+		constexpr uinteger_t::digit max = ~uinteger_t::half_digit(0);
+#endif
+		unsigned n = 0;
+		for (uinteger_t::digit p = 1; p <= max / base; p *= base) {
+			++n;
+		}
+		return n;
+	}
+
+	// Reciprocal of a normalized divisor, floor((2^128 - 1) / d) - 2^64, for
+	// division by an invariant word (Moller and Granlund, "Improved division by
+	// invariant integers").
+	static constexpr uinteger_t::digit reciprocal(uinteger_t::digit d) {
+#ifdef __SIZEOF_INT128__
+		return static_cast<uinteger_t::digit>(~double_digit(0) / d);
+#else
+		(void)d;
+		return 0;
+#endif
+	}
+
+	static constexpr unsigned bit_length(uinteger_t::digit v) {
+		return uinteger_t::digit_bits - leading_zeros(v);
+	}
+
+	// Multiplier m such that v / base is (t + ((v - t) >> 1)) >> (bit_length(base - 1) - 1)
+	// with t = (m * v) >> 64, for any word v (Granlund and Montgomery, "Division
+	// by invariant integers using multiplication").
+	static constexpr uinteger_t::digit base_reciprocal(uinteger_t::digit base) {
+#ifdef __SIZEOF_INT128__
+		auto l = bit_length(base - 1);
+		return static_cast<uinteger_t::digit>(((static_cast<double_digit>((uinteger_t::digit(1) << l) - base)) << uinteger_t::digit_bits) / base + 1);
+#else
+		(void)base;
+		return 0;
+#endif
+	}
+
+#ifdef __SIZEOF_INT128__
+	static constexpr uinteger_t::digit divide_by(uinteger_t::digit v, uinteger_t::digit inverse, unsigned shift) {
+		auto t = static_cast<uinteger_t::digit>((static_cast<double_digit>(v) * inverse) >> uinteger_t::digit_bits);
+		return (t + ((v - t) >> 1)) >> (shift - 1);
+	}
+#endif
+
+	// Divides a word by alphabet_base without a hardware division.
+	template <typename K>
+	static constexpr uinteger_t::digit divide_base(const K& k, uinteger_t::digit v) {
+#ifdef __SIZEOF_INT128__
+		return divide_by(v, k.base_inverse, k.base_shift);
+#else
+		return v / k.alphabet_base;
+#endif
+	}
+
+	// Divides the limbs in place by word_base, trimming high zero limbs, and
+	// returns the remainder.
+	uinteger_t::digit divide_words(uinteger_t::digit* words, std::size_t& words_size) const {
+#ifdef __SIZEOF_INT128__
+		const auto d = word_base << word_shift;
+		const auto s = word_shift;
+		uinteger_t::digit r = 0;  // remainder, shifted left by s
+		for (auto i = words_size; i; --i) {
+			auto u = words[i - 1];
+			auto u1 = s ? r | (u >> (uinteger_t::digit_bits - s)) : r;
+			auto u0 = u << s;
+			auto q = static_cast<double_digit>(word_inverse) * u1 + ((static_cast<double_digit>(u1) << uinteger_t::digit_bits) | u0);
+			auto q1 = static_cast<uinteger_t::digit>(q >> uinteger_t::digit_bits) + 1;
+			auto q0 = static_cast<uinteger_t::digit>(q);
+			r = u0 - q1 * d;
+			// Taken about half the time, so done with a mask, not a branch.
+			auto mask = uinteger_t::digit(0) - (r > q0);
+			q1 += mask;
+			r += mask & d;
+			if (r >= d) {
+				++q1;
+				r -= d;
+			}
+			words[i - 1] = q1;
+		}
+		r >>= s;
+#else
+		uinteger_t::digit r = 0;
+		for (auto i = words_size; i; --i) {
+			auto u = words[i - 1];
+			auto hi = (r << uinteger_t::half_digit_bits) | (u >> uinteger_t::half_digit_bits);
+			r = hi % word_base;
+			auto lo = (r << uinteger_t::half_digit_bits) | (u & ~uinteger_t::half_digit(0));
+			r = lo % word_base;
+			words[i - 1] = ((hi / word_base) << uinteger_t::half_digit_bits) | (lo / word_base);
+		}
+#endif
+		while (words_size && !words[words_size - 1]) {
+			--words_size;
+		}
+		return r;
+	}
+
+	static constexpr uinteger_t::digit power_of(int base, unsigned exp) {
+		uinteger_t::digit p = 1;
+		while (exp--) {
+			p *= base;
+		}
+		return p;
+	}
+
+	// Long division by word_base (the largest power of the base that fits in a
+	// digit), in place on the limbs, splitting each remainder into word_digits
+	// digits with native arithmetic. Digits are pushed least significant first
+	// and zero-padded up to width.
+	template <typename Result>
+	void encode_words(Result& result, int& sum, uinteger_t::digit* words, std::size_t words_size, std::size_t width) const {
+		std::size_t n = 0;
+		while (words_size) {
+			auto v = divide_words(words, words_size);
+			for (unsigned i = 0; i < word_digits && (v || words_size); ++i, ++n) {
+				auto q = divide_base(*this, v);
+				auto d = static_cast<int>(v - q * alphabet_base);
+				result.push_back(chr(d));
+				v = q;
+				sum += d;
+			}
+		}
+		for (; n < width; ++n) {
+			result.push_back(chr(0));
+		}
+	}
+
+	// Horner's rule over digit values, word_digits at a time: one bignum
+	// multiply-add per word instead of per digit.
+	uinteger_t decode_words(const unsigned char* digits, std::size_t digits_size) const {
+		uinteger_t uint_word_base = word_base;
+		uinteger_t result;
+		for (; digits_size >= word_digits; digits_size -= word_digits) {
+			uinteger_t::digit v = 0;
+			for (unsigned i = 0; i < word_digits; ++i) {
+				v = v * alphabet_base + *digits++;
+			}
+			result = (result * uint_word_base) + v;
+		}
+		if (digits_size) {
+			uinteger_t::digit v = 0;
+			for (auto i = digits_size; i; --i) {
+				v = v * alphabet_base + *digits++;
+			}
+			result = (result * power_of(alphabet_base, static_cast<unsigned>(digits_size))) + v;
+		}
+		return result;
+	}
+
+	// Values at least dc_threshold digits long are converted by divide-and-conquer
+	// instead of one digit at a time; the recursion bottoms out in the plain
+	// loops once a piece is down to dc_leaf digits.
+	static constexpr std::size_t dc_threshold = 512;
+	static constexpr std::size_t dc_leaf = 128;
+
+	// What divide-and-conquer needs of a base, shared by every BaseX with
+	// that base: its powers base^(2^k) and their reciprocals, built on demand.
+	// Each one is published once, by whichever thread gets there first, and
+	// read with a plain acquire load from then on, so threads converting with
+	// the same base do not serialize on them.
+	struct cached {
+		std::atomic<const uinteger_t*> powers[64] = {};
+		std::atomic<const uinteger_t*> reciprocals[64] = {};
+
+		~cached() {
+			for (auto& p : powers) {
+				delete p.load();
+			}
+			for (auto& r : reciprocals) {
+				delete r.load();
+			}
+		}
+	};
+
+	static cached& cache(int base) {
+		static cached all[257];
+		return all[base];
+	}
+
+	// Stores value in slot unless another thread beat us to it, and returns
+	// the one that stays.
+	static const uinteger_t& publish(std::atomic<const uinteger_t*>& slot, uinteger_t&& value) {
+		auto ours = new uinteger_t(std::move(value));
+		const uinteger_t* theirs = nullptr;
+		if (!slot.compare_exchange_strong(theirs, ours, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			delete ours;
+			return *theirs;
+		}
+		return *ours;
+	}
+
+	// Returns alphabet_base^(2^k).
+	const uinteger_t& power(unsigned k) const {
+		auto& slot = cache(alphabet_base).powers[k];
+		if (auto p = slot.load(std::memory_order_acquire)) {
+			return *p;
+		}
+		if (!k) {
+			return publish(slot, uinteger_t(alphabet_base));
+		}
+		const auto& below = power(k - 1);
+		return publish(slot, below * below);
+	}
+
+	// Divide-and-conquer encode of num < base^(2^(k+1)): split by base^(2^k)
+	// and recurse on both halves. Digits are pushed least significant first,
+	// like the plain loop; when pad is set exactly 2^(k+1) digits are emitted.
+	template <typename Result>
+	void encode_dc(Result& result, int& sum, const uinteger_t& num, unsigned k, bool pad) const {
+		if ((std::size_t(2) << k) <= dc_leaf) {
+			scratch w(num.data(), num.size());
+			encode_words(result, sum, w.data(), w.size(), pad ? (std::size_t(2) << k) : 0);
+			return;
+		}
+		auto r = divide(num, k, nullptr);
+		if (!pad && !r.first) {
+			encode_dc(result, sum, r.second, k - 1, false);
+		} else {
+			encode_dc(result, sum, r.second, k - 1, true);
+			encode_dc(result, sum, r.first, k - 1, pad);
+		}
+	}
+
+	// Pieces under parallel_leaf digits are left to encode_dc on one thread.
+	static constexpr std::size_t parallel_leaf = 8192;
+
+	// a * b with the longer factor cut into a piece per pool thread, and the
+	// partial products summed back. Without a pool it is just a * b.
+	static uinteger_t multiply(const uinteger_t& a, const uinteger_t& b, workers* pool) {
+		const auto& x = a.size() < b.size() ? b : a;
+		const auto& y = a.size() < b.size() ? a : b;
+		auto pieces = pool ? std::min(pool->size(), x.size() / 64) : 0;
+		if (pieces < 2) {
+			return a * b;
+		}
+		auto step = (x.size() + pieces - 1) / pieces;
+		std::vector<uinteger_t> parts(pieces);
+		pool->run(pieces, [&](std::size_t i) {
+			auto begin = std::min(x.size(), i * step);
+			auto end = std::min(x.size(), begin + step);
+			parts[i] = scratch(x.data() + begin, end - begin).value() * y;
+		});
+		uinteger_t result;
+		for (auto i = pieces; i; --i) {
+			result = (result << (step * uinteger_t::digit_bits)) + parts[i - 1];
+		}
+		return result;
+	}
+
+	// Returns floor(2^s / power(k)) for s = 2 * power(k).bits(), cached like
+	// the powers. Each one comes from the one below, squared and refined by a
+	// Newton step.
+	const uinteger_t& reciprocal(unsigned k, workers* pool) const {
+		auto& slot = cache(alphabet_base).reciprocals[k];
+		if (auto r = slot.load(std::memory_order_acquire)) {
+			return *r;
+		}
+		const auto& p = power(k);
+		auto s = 2 * p.bits();
+		auto one = uinteger_t(1) << s;
+		uinteger_t x;
+		if (p.size() <= 64) {
+			x = one.divmod(p).first;
+		} else {
+			// The rescaled square of the reciprocal below is under 2^s / p by
+			// a relative error of about 2^-power(k - 1).bits(); a Newton step
+			// squares the error and keeps the estimate under.
+			const auto& below = reciprocal(k - 1, pool);
+			x = multiply(below, below, pool) >> (4 * power(k - 1).bits() - s);
+			x = x + (multiply(x, one - multiply(p, x, pool), pool) >> s);
+		}
+		// Count up the last few units.
+		auto e = one - multiply(p, x, pool);
+		while (!(e < p)) {
+			e = e - p;
+			x = x + uinteger_t(1);
+		}
+		return publish(slot, std::move(x));
+	}
+
+	// Divisors shorter than barrett_limbs limbs are left to divmod, which beats
+	// the three products below at that size.
+	static constexpr std::size_t barrett_limbs = 32;
+
+	// num < power(k)^2 divided by power(k) with Barrett's method: the product
+	// with the reciprocal leaves the quotient at most one short. Long division
+	// is quadratic, so this is what keeps encode_dc at the cost of
+	// multiplication; pool, when given, spreads the products over threads.
+	std::pair<uinteger_t, uinteger_t> divide(const uinteger_t& num, unsigned k, workers* pool) const {
+		const auto& p = power(k);
+		if (p.size() < barrett_limbs) {
+			return num.divmod(p);
+		}
+		auto q = multiply(num, reciprocal(k, pool), pool) >> (2 * p.bits());
+		auto r = num - multiply(q, p, pool);
+		if (!(r < p)) {
+			r = r - p;
+			q = q + uinteger_t(1);
+		}
+		return {std::move(q), std::move(r)};
+	}
+
+	// encode_dc with the halves converted on pool, each given half of the
+	// threads available (share). Every split is divide(), its products cut
+	// into pool tasks that any idle thread can take. The low half always emits
+	// exactly 2^k digits, so the high half writes its own writer just in front
+	// of it.
+	void encode_parallel(reverse_writer& out, int& sum, const uinteger_t& num, unsigned k, bool pad, workers& pool, std::size_t share) const {
+		if (share < 2 || (std::size_t(2) << k) <= parallel_leaf) {
+			encode_dc(out, sum, num, k, pad);
+			return;
+		}
+		auto r = divide(num, k, &pool);
+		if (!pad && !r.first) {
+			encode_parallel(out, sum, r.second, k - 1, false, pool, share);
+			return;
+		}
+		auto lo = std::size_t(1) << k;
+		if (static_cast<std::size_t>(out.ptr - out.first) < lo) {
+			span<char>::overflow();
+		}
+		reverse_writer high{out.first, out.ptr - lo};
+		int high_sum = 0;
+		pool.run(2, [&](std::size_t i) {
+			if (i) {
+				encode_parallel(high, high_sum, r.first, k - 1, pad, pool, share / 2);
+			} else {
+				encode_parallel(out, sum, r.second, k - 1, true, pool, share - share / 2);
+			}
+		});
+		out.ptr = high.ptr;
+		sum += high_sum;
+	}
+
+	// Divide-and-conquer decode of a run of digit values (most significant
+	// first): the trailing 2^k digits are folded separately and joined with
+	// the rest by one multiplication by base^(2^k).
+	uinteger_t decode_dc(const unsigned char* digits, std::size_t digits_size) const {
+		if (digits_size <= dc_leaf) {
+			return decode_words(digits, digits_size);
+		}
+		unsigned k = 0;
+		while ((std::size_t(2) << k) < digits_size) ++k;
+		auto lo = std::size_t(1) << k;
+		return (decode_dc(digits, digits_size - lo) * power(k)) + decode_dc(digits + digits_size - lo, lo);
+	}
+
+	// Block padding alphabets with no check characters encode bytes, not an
+	// integer, so they go through the byte-aligned block codec.
+	constexpr bool byte_aligned() const {
+		return block_size && !(flags & (BaseX::with_check | BaseX::with_checksum));
+	}
+
+	// Byte-aligned block codec (RFC 4648): each block of block_bytes input bytes
+	// maps to block_chars characters, most significant bits first, and the last
+	// block is zero-filled and, unless pad is false, padded.
+	template <typename Result>
+	void encode_blocks(Result& result, const unsigned char* decoded, std::size_t decoded_size, bool pad = true) const {
+		const unsigned bits = alphabet_base_bits;
+		const unsigned block_bytes = bits / (bits & -bits);
+		const unsigned block_chars = 8 / (bits & -bits);
+		auto chars = (decoded_size * 8 + bits - 1) / bits;
+		auto padded = pad && padding_size ? (chars + padding_size - 1) / padding_size * padding_size : chars;
+		auto offset = result.size();
+		result.resize(offset + padded);
+		if (!padded) {
+			return;
+		}
+		auto out = &result[offset];
+		auto end = decoded + decoded_size;
+		auto vectorized = base_x_simd::encode(bits, decoded, decoded_size, reinterpret_cast<char*>(out), _chr);
+		decoded += vectorized;
+		out += vectorized / block_bytes * block_chars;
+		if (_digrams) {
+			// As many blocks per step as fit in a 64-bit word, each holding an
+			// even number of characters.
+			const auto pair_mask = (std::uint64_t(1) << (2 * bits)) - 1;
+			const unsigned step_bytes = 8 / block_bytes * block_bytes;
+			const unsigned step_chars = step_bytes * 8 / bits;
+			for (; static_cast<std::size_t>(end - decoded) >= step_bytes; decoded += step_bytes) {
+				std::uint64_t v = 0;
+				for (unsigned i = 0; i < step_bytes; ++i) {
+					v = (v << 8) | decoded[i];
+				}
+				for (unsigned i = step_chars; i; i -= 2, out += 2) {
+					std::memcpy(out, _digrams + 2 * ((v >> ((i - 2) * bits)) & pair_mask), 2);
+				}
+			}
+		}
+		for (; static_cast<std::size_t>(end - decoded) >= block_bytes; decoded += block_bytes) {
+			uinteger_t::digit v = 0;
+			for (unsigned i = 0; i < block_bytes; ++i) {
+				v = (v << 8) | decoded[i];
+			}
+			for (unsigned i = block_chars; i; --i) {
+				*out++ = chr(static_cast<int>((v >> ((i - 1) * bits)) & alphabet_base_mask));
+			}
+		}
+		if (decoded != end) {
+			uinteger_t::digit v = 0;
+			for (unsigned i = 0; i < block_bytes; ++i) {
+				v = (v << 8) | (decoded != end ? *decoded++ : 0);
+			}
+			for (unsigned i = block_chars; out != &result[offset] + chars; --i) {
+				*out++ = chr(static_cast<int>((v >> ((i - 1) * bits)) & alphabet_base_mask));
+			}
+		}
+		for (auto i = chars; i < padded; ++i) {
+			*out++ = padding;
+		}
+	}
+
+	// The offset of the first character that is neither a digit nor ignored,
+	// up to the first padding character, or encoded_size if there is none.
+	std::size_t first_invalid(const char* encoded, std::size_t encoded_size) const {
+		for (std::size_t i = 0; i < encoded_size; ++i) {
+			i += base_x_simd::validate(encoded + i, encoded_size - i, _ranges);
+			if (i == encoded_size || encoded[i] == padding) break;
+			if (ord(static_cast<int>(encoded[i])) >= alphabet_base) {
+				return i;
+			}
+		}
+		return encoded_size;
+	}
+
+	// Results up to this many bytes are decoded on the stack when growing the
+	// result would allocate.
+	static constexpr std::size_t staged_size = 4096;
+
+	// Appends to result what write(out, written) decodes from encoded, at most
+	// room bytes; write returns the status and sets written. A failed decode
+	// must not allocate, so when result has to grow, short results are
+	// decoded on the stack and copied over once they pass, and longer ones
+	// only after their characters are checked (offsets count from encoded).
+	template <typename Result, typename Write>
+	status append_decoded(Result& result, std::size_t room, const char* encoded, std::size_t encoded_size, Write&& write) const {
+		auto begin = result.size();
+		std::size_t written = 0;
+		if (begin + room > result.capacity()) {
+			if (room <= staged_size) {
+				unsigned char staged[staged_size];
+				auto st = write(staged, written);
+				if (st && written) {
+					result.resize(begin + written);
+					std::memcpy(reinterpret_cast<unsigned char*>(result.data()) + begin, staged, written);
+				}
+				return st;
+			}
+			auto at = first_invalid(encoded, encoded_size);
+			if (at != encoded_size) {
+				return {errc::invalid_character, at};
+			}
+		}
+		result.resize(begin + room);
+		auto st = write(reinterpret_cast<unsigned char*>(result.data()) + begin, written);
+		result.resize(begin + written);
+		return st;
+	}
+
+	template <typename Result>
+	status decode_blocks(Result& result, const char* encoded, std::size_t encoded_size) const {
+		result.clear();
+		return decoder(*this).feed(result, encoded, encoded_size);
+	}
+
+	// Hex alphabets with no check characters map every byte to two digits, so
+	// bytes go through the block codec once leading zero bytes (and a leading
+	// zero digit) are dropped, the way the integer path drops them.
+	constexpr bool hex_aligned() const {
+		return alphabet_base_bits == 4 && !block_size && !(flags & (BaseX::with_check | BaseX::with_checksum));
+	}
+
+	template <typename Result>
+	void encode_hex(Result& result, const unsigned char* decoded, std::size_t decoded_size) const {
+		while (decoded_size && !*decoded) {
+			++decoded;
+			--decoded_size;
+		}
+		if (!decoded_size) {
+			result.push_back(chr(0));
+			return;
+		}
+		if (*decoded < 16) {
+			result.push_back(chr(*decoded++));
+			--decoded_size;
+		}
+		encode_blocks(result, decoded, decoded_size);
+	}
+
+	// Returns false, leaving result unspecified, when the input holds anything
+	// but digits; the integer path then decodes it or reports the error.
+	template <typename Result>
+	bool decode_hex(Result& result, const char* encoded, std::size_t encoded_size) const {
+		if (!encoded_size) {
+			return false;
+		}
+		// Leading zero digits are skipped, so the first byte is not zero
+		// (unless the value is).
+		while (encoded_size > 1 && !ord(static_cast<int>(*encoded))) {
+			++encoded;
+			--encoded_size;
+		}
+		result.clear();
+		return append_decoded(result, (encoded_size + 1) / 2, encoded, encoded_size, [&](unsigned char* out, std::size_t& written) -> status {
+			auto first = out;
+			std::size_t i = 0;
+			if (encoded_size & 1) {
+				auto d = ord(static_cast<int>(encoded[i++]));
+				if (d < 0 || d >= 16) return {errc::invalid_character, 0};
+				*out++ = static_cast<unsigned char>(d);
+			}
+			auto vectorized = base_x_simd::decode(4, encoded + i, encoded_size - i, out, _ranges);
+			i += vectorized;
+			out += vectorized / 2;
+			for (; i < encoded_size; i += 2) {
+				auto hi = ord(static_cast<int>(encoded[i]));
+				auto lo = ord(static_cast<int>(encoded[i + 1]));
+				if (hi < 0 || hi >= 16 || lo < 0 || lo >= 16) return {errc::invalid_character, i};
+				*out++ = static_cast<unsigned char>((hi << 4) | lo);
+			}
+			written = static_cast<std::size_t>(out - first);
+			return {};
+		}).ok();
+	}
+
+	// The integer encode of a native word, digits written back to front up to
+	// end (which has room for the check characters after it); returns the
+	// text. Block padding alphabets shift the value first and go through
+	// encode_num instead.
+	template <typename K>
+	std::string_view encode_word(char* end, std::uint64_t value) const {
+		auto&& k = params<K>();
+		auto ptr = end;
+		if (!value) {
+			*--ptr = chr(0);
+			return {ptr, 1};
+		}
+		int sum = 0;
+		int chk = (k.flags & BaseX::with_check) ? static_cast<int>(value % k.size) : 0;
+		if (k.alphabet_base_bits && _digrams) {
+			// Two digits per step while more than two are left.
+			const unsigned pair_bits = 2 * k.alphabet_base_bits;
+			for (; value >> pair_bits; value >>= pair_bits) {
+				auto p = static_cast<unsigned>(value & ((1u << pair_bits) - 1));
+				ptr -= 2;
+				std::memcpy(ptr, _digrams + 2 * p, 2);
+				sum += static_cast<int>((p >> k.alphabet_base_bits) + (p & k.alphabet_base_mask));
+			}
+		}
+		do {
+			int d;
+			if (k.alphabet_base_bits) {
+				d = static_cast<int>(value & k.alphabet_base_mask);
+				value >>= k.alphabet_base_bits;
+			} else {
+				auto q = divide_base(k, value);
+				d = static_cast<int>(value - q * k.alphabet_base);
+				value = q;
+			}
+			*--ptr = chr(d);
+			sum += d;
+		} while (value);
+		return append_digits(k, ptr, end, sum, chk);
+	}
+
+	// Writes the check and checksum characters after the digits in [ptr, end),
+	// which must have room for two more, and returns the whole text.
+	template <typename K>
+	std::string_view append_digits(const K& k, char* ptr, char* end, int sum, int chk) const {
+		if (k.flags & BaseX::with_check) {
+			*end++ = chr(chk);
+			sum += chk;
+		}
+		if (k.flags & BaseX::with_checksum) {
+			auto sz = static_cast<int>(end - ptr);
+			sz = (sz + sz / k.size) % k.size;
+			sum += sz;
+			sum = (k.size - sum % k.size) % k.size;
+			*end++ = chr(sum);
+		}
+		return {ptr, static_cast<std::size_t>(end - ptr)};
+	}
+
+#ifdef __SIZEOF_INT128__
+	// Fixed-width engine for 128 and 256-bit keys (UUIDs, digests) in
+	// non-power-of-two bases. The limbs live in a std::array and every loop
+	// over them has a compile-time trip count, so the long division by
+	// word_base unrolls.
+	template <std::size_t N>
+	using fixed = std::array<uinteger_t::digit, N>;
+
+	// Divides the little-endian limbs in place by word_base and returns the
+	// remainder (the divide_words step, unrolled).
+	template <std::size_t N, typename K>
+	static uinteger_t::digit divide_fixed(const K& k, fixed<N>& words) {
+		const auto d = k.word_base << k.word_shift;
+		const auto s = k.word_shift;
+		uinteger_t::digit r = 0;  // remainder, shifted left by s
+		for (std::size_t i = N; i; --i) {
+			auto u = words[i - 1];
+			if (!r && u < k.word_base) {
+				// The high limbs of a shrinking value are all remainder.
+				words[i - 1] = 0;
+				r = u << s;
+				continue;
+			}
+			auto u1 = s ? r | (u >> (uinteger_t::digit_bits - s)) : r;
+			auto u0 = u << s;
+			auto q = static_cast<double_digit>(k.word_inverse) * u1 + ((static_cast<double_digit>(u1) << uinteger_t::digit_bits) | u0);
+			auto q1 = static_cast<uinteger_t::digit>(q >> uinteger_t::digit_bits) + 1;
+			auto q0 = static_cast<uinteger_t::digit>(q);
+			r = u0 - q1 * d;
+			// Taken about half the time, so done with a mask, not a branch.
+			auto mask = uinteger_t::digit(0) - (r > q0);
+			q1 += mask;
+			r += mask & d;
+			if (r >= d) {
+				++q1;
+				r -= d;
+			}
+			words[i - 1] = q1;
+		}
+		return r >> s;
+	}
+
+	// Reads a big-endian limb (compilers turn the loop into a byte swap).
+	static uinteger_t::digit load_digit(const unsigned char* bytes) {
+		uinteger_t::digit w = 0;
+		for (std::size_t i = 0; i < sizeof(w); ++i) {
+			w = (w << 8) | bytes[i];
+		}
+		return w;
+	}
+
+	template <std::size_t N>
+	static bool is_zero(const fixed<N>& words) {
+		uinteger_t::digit any = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			any |= words[i];
+		}
+		return !any;
+	}
+
+	template <std::size_t N>
+	static int mod_fixed(const fixed<N>& words, int divisor) {
+		uinteger_t::digit r = 0;
+		for (std::size_t i = N; i; --i) {
+			r = ((r << uinteger_t::half_digit_bits) | (words[i - 1] >> uinteger_t::half_digit_bits)) % divisor;
+			r = ((r << uinteger_t::half_digit_bits) | (words[i - 1] & ~uinteger_t::half_digit(0))) % divisor;
+		}
+		return static_cast<int>(r);
+	}
+
+	// Encodes up to N limbs' worth of big-endian bytes, like encode_word.
+	template <std::size_t N, typename K>
+	std::string_view encode_fixed(char* end, const unsigned char* decoded, std::size_t decoded_size) const {
+		auto&& k = params<K>();
+		unsigned char bytes[N * sizeof(uinteger_t::digit)] = {};
+		std::memcpy(bytes + sizeof(bytes) - decoded_size, decoded, decoded_size);
+		fixed<N> words;
+		for (std::size_t i = 0; i < N; ++i) {
+			words[i] = load_digit(bytes + (N - 1 - i) * sizeof(uinteger_t::digit));
+		}
+		auto ptr = end;
+		if (is_zero(words)) {
+			*--ptr = chr(0);
+			return {ptr, 1};
+		}
+		int sum = 0;
+		int chk = (k.flags & BaseX::with_check) ? mod_fixed(words, k.size) : 0;
+		// Character stores may alias the members, so keep them in locals.
+		const auto table = _chr;
+		const uinteger_t::digit base = k.alphabet_base;
+		const auto inverse = k.small_inverse;
+		const auto half = k.half_base;
+		const auto half_inv = k.half_inverse;
+		const auto half_sh = k.half_shift;
+		const auto digits = k.word_digits;
+		const auto half_n = k.half_digits;
+		// For v < 2^64 / base a single multiply divides: floor(2^64 / base) + 1
+		// overshoots 2^64 / base by less than one, so the error stays under
+		// 1 / base.
+		auto div = [inverse](uinteger_t::digit v) {
+			return static_cast<uinteger_t::digit>((static_cast<double_digit>(v) * inverse) >> uinteger_t::digit_bits);
+		};
+		bool more;
+		do {
+			// Each chunk is split at half_base and both halves are cut at once,
+			// which halves the length of the dependency chain; only the
+			// highest chunk stops at its last nonzero digit.
+			auto v = divide_fixed(k, words);
+			more = !is_zero(words);
+			auto hi = divide_by(v, half_inv, half_sh);
+			auto lo = v - hi * half;
+			unsigned n = 0;  // digits written for this chunk
+			if (more) {
+				auto mid = ptr - half_n;
+				for (unsigned i = 0; i < half_n; ++i) {
+					auto qh = div(hi);
+					auto ql = div(lo);
+					auto dh = static_cast<int>(hi - qh * base);
+					auto dl = static_cast<int>(lo - ql * base);
+					*--mid = table[dh];
+					*--ptr = table[dl];
+					sum += dh + dl;
+					hi = qh;
+					lo = ql;
+				}
+				ptr = mid;
+				lo = hi;
+				n = 2 * half_n;
+			} else if (hi) {
+				for (unsigned i = 0; i < half_n; ++i) {
+					auto q = div(lo);
+					auto d = static_cast<int>(lo - q * base);
+					*--ptr = table[d];
+					sum += d;
+					lo = q;
+				}
+				lo = hi;
+			}
+			for (; more ? n < digits : lo != 0; ++n) {
+				auto q = div(lo);
+				auto d = static_cast<int>(lo - q * base);
+				*--ptr = table[d];
+				sum += d;
+				lo = q;
+			}
+		} while (more);
+		return append_digits(k, ptr, end, sum, chk);
+	}
+
+	// The decode_word counterpart on N limbs: digits are folded word_digits at
+	// a time with one multiply-add over the limbs. Errors are the ones the
+	// uinteger_t path reports, except out_of_range: the value overflows and
+	// only the uinteger_t path can decode it.
+	template <std::size_t N, typename K>
+	status decode_fixed(fixed<N>& result, const char* encoded, std::size_t encoded_size) const {
+		auto&& k = params<K>();
+		fixed<N> words{};
+		auto begin = encoded;
+		int sum = 0;
+		int sumsz = 0;
+		auto fold = [&](uinteger_t::digit multiplier, uinteger_t::digit v) {
+			for (std::size_t i = 0; i < N; ++i) {
+				auto t = static_cast<double_digit>(words[i]) * multiplier + v;
+				words[i] = static_cast<uinteger_t::digit>(t);
+				v = static_cast<uinteger_t::digit>(t >> uinteger_t::digit_bits);
+			}
+			return !v;
+		};
+
+		auto sz = encoded_size;
+		if (k.flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (k.flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		uinteger_t::digit v = 0;
+		unsigned vn = 0;
+		for (; sz; --sz, ++encoded) {
+			auto c = *encoded;
+			if (c == k.padding) break;
+			auto d = ord(static_cast<int>(c));
+			if (d < 0) continue; // ignored character
+			if (d >= k.alphabet_base) return {errc::invalid_character, static_cast<std::size_t>(encoded - begin)};
+			v = v * k.alphabet_base + d;
+			sum += d;
+			++sumsz;
+			if (++vn == k.word_digits) {
+				if (!fold(k.word_base, v)) return {errc::out_of_range, 0};
+				v = 0;
+				vn = 0;
+			}
+		}
+		if (vn && !fold(power_of(k.alphabet_base, vn), v)) return {errc::out_of_range, 0};
+
+		auto st = decode_trailer(k, begin, begin + encoded_size, encoded, sz, sum, sumsz, [&] { return mod_fixed(words, k.size); });
+		if (st) {
+			result = words;
+		}
+		return st;
+	}
+
+	// decode_fixed for a batch record: the value goes right-aligned in
+	// record_size bytes. The loop takes digits only; texts with anything else
+	// (ignored characters, padding, invalid ones) go through decode_fixed.
+	// Statuses are decode_fixed's, with out_of_range also for values over
+	// record_size bytes.
+	template <std::size_t N, typename K>
+	status decode_record_fixed(unsigned char* record, std::size_t record_size, std::string_view text) const {
+		auto&& k = params<K>();
+		fixed<N> words{};
+		auto fold = [&](uinteger_t::digit multiplier, uinteger_t::digit v) {
+			for (std::size_t i = 0; i < N; ++i) {
+				auto t = static_cast<double_digit>(words[i]) * multiplier + v;
+				words[i] = static_cast<uinteger_t::digit>(t);
+				v = static_cast<uinteger_t::digit>(t >> uinteger_t::digit_bits);
+			}
+			return !v;
+		};
+
+		auto sz = text.size();
+		if (k.flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (k.flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		// Anything but a digit shows up as one out of range, which is only
+		// noted: no branch per character.
+		uinteger_t::digit v = 0;
+		unsigned vn = 0;
+		int sum = 0;
+		bool bad = false;
+		for (std::size_t i = 0; i < sz; ++i) {
+			auto d = ord(static_cast<int>(text[i]));
+			bad |= static_cast<unsigned>(d) >= static_cast<unsigned>(k.alphabet_base);
+			v = v * k.alphabet_base + static_cast<unsigned>(d);
+			sum += d;
+			if (++vn == k.word_digits) {
+				bad |= !fold(k.word_base, v);
+				v = 0;
+				vn = 0;
+			}
+		}
+		if (vn) {
+			bad |= !fold(power_of(k.alphabet_base, vn), v);
+		}
+
+		auto begin = text.data();
+		auto st = bad
+			? decode_fixed<N, K>(words, begin, text.size())
+			: decode_trailer(k, begin, begin + text.size(), begin + sz, 0, sum, static_cast<int>(sz), [&] { return mod_fixed(words, k.size); });
+		if (!st) {
+			return st;
+		}
+		auto out = record + record_size;
+		for (std::size_t b = 0; b < N * sizeof(uinteger_t::digit); ++b) {
+			auto byte = static_cast<unsigned char>(words[b / sizeof(uinteger_t::digit)] >> (8 * (b % sizeof(uinteger_t::digit))));
+			if (b < record_size) {
+				*--out = byte;
+			} else if (byte) {
+				return {errc::out_of_range, 0};
+			}
+		}
+		return st;
+	}
+#endif
+
+	// Writes little-endian limbs as big-endian bytes without leading zeros,
+	// what uinteger_t::str(256) gives; zero is a single zero byte.
+	template <typename Result>
+	static void assign_bytes(Result& result, const uinteger_t::digit* words, std::size_t words_size) {
+		while (words_size && !words[words_size - 1]) {
+			--words_size;
+		}
+		if (!words_size) {
+			result.resize(1);
+			result[0] = 0;
+			return;
+		}
+		auto n = (words_size * uinteger_t::digit_bits - leading_zeros(words[words_size - 1]) + 7) / 8;
+		result.resize(n);
+		// Back to front, a limb at a time: each one is read once, before the
+		// byte stores (which may alias it).
+		auto first = reinterpret_cast<unsigned char*>(&result[0]);
+		auto out = first + n;
+		for (std::size_t i = 0; out != first; ++i) {
+			auto w = words[i];
+			for (std::size_t b = 0; b < sizeof(w) && out != first; ++b, w >>= 8) {
+				*--out = static_cast<unsigned char>(w);
+			}
+		}
+	}
+
+	// The integer decode on a native word, for values that fit one: same digits,
+	// shift, check and checksum, and the same errors, except out_of_range: the
+	// value overflows the word and is left to the uinteger_t path.
+	template <typename K>
+	status decode_word(std::uint64_t& result, const char* encoded, std::size_t encoded_size) const {
+		auto&& k = params<K>();
+		constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+		const auto limit = max / static_cast<unsigned>(k.alphabet_base);
+		const auto last = max % static_cast<unsigned>(k.alphabet_base);
+		std::uint64_t value = 0;
+		int sum = 0;
+		int sumsz = 0;
+		auto begin = encoded;
+
+		auto sz = encoded_size;
+		if (k.flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (k.flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		for (; sz; --sz, ++encoded) {
+			auto c = *encoded;
+			if (c == k.padding) break;
+			auto d = ord(static_cast<int>(c));
+			if (d < 0) continue; // ignored character
+			if (d >= k.alphabet_base) return {errc::invalid_character, static_cast<std::size_t>(encoded - begin)};
+			// Rarely true, so tested first: with a constant last, compilers
+			// would otherwise branch on the digit.
+			if (value >= limit && (value > limit || static_cast<unsigned>(d) > last)) return {errc::out_of_range, 0};
+			value = value * k.alphabet_base + d;
+			sum += d;
+			++sumsz;
+		}
+		if (k.block_size) {
+			value >>= (k.block_size * sumsz) & 7;
+		}
+
+		auto st = decode_trailer(k, begin, begin + encoded_size, encoded, sz, sum, sumsz, [&] { return static_cast<int>(value % k.size); });
+		if (st) {
+			result = value;
+		}
+		return st;
+	}
+
+	struct codec {
+		std::string_view (BaseX::*encode_word)(char*, std::uint64_t) const;
+		status (BaseX::*decode_word)(std::uint64_t&, const char*, std::size_t) const;
+#ifdef __SIZEOF_INT128__
+		std::string_view (BaseX::*encode_fixed16)(char*, const unsigned char*, std::size_t) const;
+		std::string_view (BaseX::*encode_fixed32)(char*, const unsigned char*, std::size_t) const;
+		status (BaseX::*decode_fixed32)(fixed<32 / sizeof(uinteger_t::digit)>&, const char*, std::size_t) const;
+		status (BaseX::*decode_record16)(unsigned char*, std::size_t, std::string_view) const;
+		status (BaseX::*decode_record32)(unsigned char*, std::size_t, std::string_view) const;
+#endif
+	};
+
+	template <typename K>
+	static constexpr codec codec_for{
+		&BaseX::encode_word<K>,
+		&BaseX::decode_word<K>,
+#ifdef __SIZEOF_INT128__
+		&BaseX::encode_fixed<16 / sizeof(uinteger_t::digit), K>,
+		&BaseX::encode_fixed<32 / sizeof(uinteger_t::digit), K>,
+		&BaseX::decode_fixed<32 / sizeof(uinteger_t::digit), K>,
+		&BaseX::decode_record_fixed<16 / sizeof(uinteger_t::digit), K>,
+		&BaseX::decode_record_fixed<32 / sizeof(uinteger_t::digit), K>,
+#endif
+	};
+
+	// Appends the encoding of a native word.
+	template <typename Result>
+	void append_word(Result& result, std::uint64_t value) const {
+		char buffer[64 + 2];
+		auto text = (this->*_codec->encode_word)(buffer + 64, value);
+		result.append(text.data(), text.data() + text.size());
+	}
+
+	// Encodes the value held in the scratch limbs, which long division consumes.
+	// input, when given, is the same value as a uinteger_t for the
+	// divide-and-conquer path, which runs on pool when there is one.
+	template <typename Result>
+	void encode_num(Result& result, scratch& num, const uinteger_t* input, workers* pool = nullptr) const {
+		std::size_t bp = 0;
+		if (block_size) {
+			bp = ((num.bits() + 7) & ~std::size_t(7)) % block_size;
+			bp = bp ? (block_size - bp) % block_size : 0;
+			num.shift_left(bp);
+		}
+		auto num_sz = num.size();
+		if (!num_sz) {
+			result.push_back(chr(0));
+			return;
+		}
+		int sum = 0;
+		int chk = (flags & BaseX::with_check) ? num.mod(size) : 0;
+		// The digits are written back to front from the end of the room made
+		// for them, then moved down to where the result ends.
+		auto offset = result.size();
+		auto room = make_room(result, num_sz * base_size + padding_size + 2);
+		auto first = reinterpret_cast<char*>(&result[0]) + offset;
+		auto last = first + room;
+		reverse_writer out{first, last};
+		if (alphabet_base_bits) {
+			// Exactly as many digits as the value has bits for, so no high
+			// zero digits need trimming.
+			auto words = num.data();
+			auto digits = (num.bits() + alphabet_base_bits - 1) / alphabet_base_bits;
+			auto slice = [&](std::size_t bit, unsigned width) {
+				auto w = bit / uinteger_t::digit_bits;
+				auto o = bit % uinteger_t::digit_bits;
+				auto v = words[w] >> o;
+				if (o + width > uinteger_t::digit_bits && w + 1 < num_sz) {
+					v |= words[w + 1] << (uinteger_t::digit_bits - o);
+				}
+				return v;
+			};
+			std::size_t i = 0;
+			if (_digrams) {
+				const unsigned pair_bits = 2 * alphabet_base_bits;
+				const auto pair_mask = (uinteger_t::digit(1) << pair_bits) - 1;
+				for (; i + 2 <= digits; i += 2) {
+					auto p = slice(i * alphabet_base_bits, pair_bits) & pair_mask;
+					out.push_pair(_digrams + 2 * p);
+					sum += static_cast<int>((p >> alphabet_base_bits) + (p & alphabet_base_mask));
+				}
+			}
+			for (; i < digits; ++i) {
+				auto d = static_cast<int>(slice(i * alphabet_base_bits, alphabet_base_bits) & alphabet_base_mask);
+				out.push_back(chr(d));
+				sum += d;
+			}
+		} else if (num_sz * base_size >= dc_threshold) {
+			uinteger_t value;
+			if (!input) {
+				value = num.value();
+				input = &value;
+			}
+			unsigned k = 0;
+			while (power(k + 1).bits() <= num.bits()) ++k;
+			if (pool) {
+				encode_parallel(out, sum, *input, k, false, *pool, pool->size());
+			} else {
+				encode_dc(out, sum, *input, k, false);
+			}
+		} else {
+			encode_words(out, sum, num.data(), num_sz, 0);
+		}
+		auto n = static_cast<std::size_t>(last - out.ptr);
+		std::memmove(first, out.ptr, n);
+		auto end = first + n;
+		auto pad = padding_size ? (padding_size - n % padding_size) % padding_size : 0;
+		auto tail = pad + ((flags & BaseX::with_check) ? 1 : 0) + ((flags & BaseX::with_checksum) ? 1 : 0);
+		if (static_cast<std::size_t>(last - end) < tail) {
+			span<char>::overflow();
+		}
+		end = std::fill_n(end, pad, padding);
+		if (flags & BaseX::with_check) {
+			*end++ = chr(chk);
+			sum += chk;
+		}
+		if (flags & BaseX::with_checksum) {
+			auto sz = static_cast<int>(end - first);
+			sz = (sz + sz / size) % size;
+			sum += sz;
+			sum = (size - sum % size) % size;
+			*end++ = chr(sum);
+		}
+		result.resize(offset + static_cast<std::size_t>(end - first));
+	}
+
+	// Integers are counted as encodes of their significant bytes.
+	template <typename Result>
+	void encode_uinteger(Result& result, const uinteger_t& input, workers* pool = nullptr) const {
+		auto size = result.size();
+		scratch num(input.data(), input.size(), memory_of(result));
+		encode_num(result, num, &input, pool);
+		note_encode(num_path(), (input.bits() + 7) / 8, result.size() - size);
+	}
+
+	template <typename Result, typename T>
+	void encode_integral(Result& result, T value) const {
+		if (sizeof(T) > sizeof(std::uint64_t) || value < T(0)) {
+			encode_uinteger(result, uinteger_t(value));
+			return;
+		}
+		auto size = result.size();
+		auto v = static_cast<std::uint64_t>(value);
+		if (!block_size) {
+			append_word(result, v);
+			note_encode(path::native, sizeof(T), result.size() - size);
+			return;
+		}
+		unsigned char bytes[sizeof(v)];
+		for (auto i = sizeof(v); i; --i, v >>= 8) {
+			bytes[i - 1] = static_cast<unsigned char>(v);
+		}
+		scratch num(bytes, sizeof(bytes));
+		encode_num(result, num, nullptr);
+		note_encode(num_path(), sizeof(T), result.size() - size);
+	}
+
+	template <typename Result>
+	void encode_bytes(Result& result, const unsigned char* decoded, std::size_t decoded_size, workers* pool = nullptr) const {
+		auto size = result.size();
+		auto taken = encode_any(result, decoded, decoded_size, pool);
+		note_encode(taken, decoded_size, result.size() - size);
+	}
+
+	template <typename Result>
+	path encode_any(Result& result, const unsigned char* decoded, std::size_t decoded_size, workers* pool) const {
+		if (byte_aligned()) {
+			encode_blocks(result, decoded, decoded_size);
+			return path::blocks;
+		}
+		if (hex_aligned()) {
+			encode_hex(result, decoded, decoded_size);
+			return path::packed;
+		}
+		if (decoded_size <= sizeof(std::uint64_t) && !block_size) {
+			std::uint64_t value = 0;
+			for (std::size_t i = 0; i < decoded_size; ++i) {
+				value = (value << 8) | decoded[i];
+			}
+			append_word(result, value);
+			return path::native;
+		}
+#ifdef __SIZEOF_INT128__
+		if (decoded_size <= 32 && !block_size && !alphabet_base_bits) {
+			char buffer[256 + 2];
+			auto text = (this->*(decoded_size <= 16 ? _codec->encode_fixed16 : _codec->encode_fixed32))(buffer + 256, decoded, decoded_size);
+			result.append(text.data(), text.data() + text.size());
+			return path::fixed;
+		}
+#endif
+		scratch num(decoded, decoded_size, memory_of(result));
+		encode_num(result, num, nullptr, pool);
+		return num_path();
+	}
+
+	// Checks whatever follows the digits, from encoded on: padding, then the
+	// check and checksum characters, up to end. check() yields the decoded
+	// value modulo size; offsets are counted from begin. A text too short to
+	// hold a check or checksum character fails its check.
+	template <typename K, typename Check>
+	status decode_trailer(const K& k, const char* begin, const char* end, const char* encoded, std::size_t sz, int sum, int sumsz, Check&& check) const {
+		for (; sz && *encoded == k.padding; --sz, ++encoded);
+
+		if (k.flags & BaseX::with_check) {
+			auto offset = static_cast<std::size_t>(encoded - begin);
+			if (encoded == end) {
+				return {errc::invalid_check, offset};
+			}
+			auto d = ord(static_cast<int>(*encoded));
+			if (d < 0 || d >= k.size) {
+				return {errc::invalid_character, offset};
+			}
+			auto chk = check();
+			if (d != chk) {
+				return {errc::invalid_check, offset};
+			}
+			sum += chk;
+			++sumsz;
+			++encoded;
+		}
+
+		if (k.flags & BaseX::with_checksum) {
+			auto offset = static_cast<std::size_t>(encoded - begin);
+			if (encoded == end) {
+				return {errc::invalid_checksum, offset};
+			}
+			auto d = ord(static_cast<int>(*encoded));
+			if (d < 0 || d >= k.size) {
+				return {errc::invalid_character, offset};
+			}
+			sum += d;
+			sum += (sumsz + sumsz / k.size) % k.size;
+			if (sum % k.size) {
+				return {errc::invalid_checksum, offset};
+			}
+		}
+		return {};
+	}
+
+	// Power-of-two alphabets: the limbs are stored into a uinteger_t or
+	// written out as bytes straight from scratch, once they are validated.
+	template <typename Result>
+	status decode_packed(Result& result, const char* encoded, std::size_t encoded_size) const {
+		int sum = 0;
+		int sumsz = 0;
+		auto begin = encoded;
+
+		auto sz = encoded_size;
+		if (flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		// Digits are packed straight into limbs from the last (least
+		// significant) character backwards, so nothing is ever shifted.
+		auto end = static_cast<const char*>(std::memchr(encoded, padding, sz));
+		auto digits_size = end ? static_cast<std::size_t>(end - encoded) : sz;
+		auto limbs = digits_size * alphabet_base_bits / uinteger_t::digit_bits + 1;
+		if (!scratch::fits(limbs) && !memory_of(result)) {
+			auto at = first_invalid(encoded, digits_size);
+			if (at != digits_size) {
+				return {errc::invalid_character, at};
+			}
+		}
+		scratch num(limbs, memory_of(result));
+		auto words = num.data();
+		std::size_t words_size = 0;
+		uinteger_t::digit v = 0;
+		std::size_t fill = 0;
+		for (auto ptr = encoded + digits_size; ptr != encoded;) {
+			auto c = *--ptr;
+			auto d = ord(static_cast<int>(c));
+			if (d < 0) continue; // ignored character
+			if (d >= alphabet_base) {
+				// Report the first invalid character, as a forward scan would.
+				for (ptr = encoded; ord(static_cast<int>(*ptr)) < alphabet_base; ++ptr);
+				return {errc::invalid_character, static_cast<std::size_t>(ptr - begin)};
+			}
+			sum += d;
+			++sumsz;
+			v |= static_cast<uinteger_t::digit>(d) << fill;
+			fill += alphabet_base_bits;
+			if (fill >= uinteger_t::digit_bits) {
+				words[words_size++] = v;
+				fill -= uinteger_t::digit_bits;
+				v = fill ? static_cast<uinteger_t::digit>(d) >> (alphabet_base_bits - fill) : 0;
+			}
+		}
+		if (fill) {
+			words[words_size++] = v;
+		}
+		num.resize(words_size);
+		num.shift_right((block_size * sumsz) & 7);
+		encoded += digits_size;
+		sz -= digits_size;
+		auto st = decode_trailer(*this, begin, begin + encoded_size, encoded, sz, sum, sumsz, [&] { return num.mod(size); });
+		if (st) {
+			store(result, num);
+		}
+		return st;
+	}
+
+	static void store(uinteger_t& result, const scratch& num) {
+		result = num.value();
+	}
+
+	template <typename Result>
+	static void store(Result& result, const scratch& num) {
+		assign_bytes(result, num.data(), num.size());
+	}
+
+	// try_decode() of a uinteger_t. The decodes built on it call this
+	// instead, to be counted once, as themselves; those to a std::pmr result
+	// pass its memory, which the digits gathered for decode_dc come from.
+	status decode_num(uinteger_t& result, const char* encoded, std::size_t encoded_size, memory_resource* memory = nullptr) const {
+		if (alphabet_base_bits) {
+			return decode_packed(result, encoded, encoded_size);
+		}
+
+		// Digits are folded word_digits at a time; long inputs are gathered as
+		// digit values and folded by decode_dc.
+		result = 0;
+		int sum = 0;
+		int sumsz = 0;
+		int direction = 1;
+		auto begin = encoded;
+
+		auto sz = encoded_size;
+		if (flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
 
-#include "uinteger_t.hh"
+		bool dc = sz >= dc_threshold;
+		if (dc && !memory) {
+			auto at = first_invalid(encoded, sz);
+			if (at != sz) {
+				return {errc::invalid_character, at};
+			}
+		}
+		uinteger_t uint_word_base = word_base;
+		uinteger_t::digit v = 0;
+		unsigned vn = 0;
+		scratch buffer(dc ? sz / sizeof(uinteger_t::digit) + 1 : 0, memory);
+		auto digits = reinterpret_cast<unsigned char*>(buffer.data());
+		std::size_t digits_size = 0;
+		for (; sz; --sz, encoded += direction) {
+			if (dc) {
+				auto out = digits + digits_size;
+				auto translated = base_x_simd::translate(encoded, sz, out, _ranges);
+				for (std::size_t i = 0; i < translated; ++i) {
+					sum += out[i];
+				}
+				sumsz += static_cast<int>(translated);
+				digits_size += translated;
+				encoded += translated;
+				sz -= translated;
+				if (!sz) break;
+			}
+			auto c = *encoded;
+			if (c == padding) break;
+			auto d = ord(static_cast<int>(c));
+			if (d < 0) continue; // ignored character
+			if (d >= alphabet_base) {
+				return {errc::invalid_character, static_cast<std::size_t>(encoded - begin)};
+			}
+			sum += d;
+			++sumsz;
+			if (dc) {
+				digits[digits_size++] = static_cast<unsigned char>(d);
+			} else {
+				v = v * alphabet_base + d;
+				if (++vn == word_digits) {
+					result = (result * uint_word_base) + v;
+					v = 0;
+					vn = 0;
+				}
+			}
+		}
+		if (dc) {
+			result = decode_dc(digits, digits_size);
+		} else if (vn) {
+			result = (result * power_of(alphabet_base, vn)) + v;
+		}
 
+		return decode_trailer(*this, begin, begin + encoded_size, encoded, sz, sum, sumsz, [&] { return static_cast<int>(result % size); });
+	}
 
-class BaseX {
-	char _chr[256];
-	int _ord[256];
+	// Every decode to bytes and every encode of bytes goes through these,
+	// which count it by the path the *_any() below took.
+	template <typename Result>
+	status decode_bytes(Result& result, const char* encoded, std::size_t encoded_size) const {
+		path taken;
+		auto st = decode_any(result, encoded, encoded_size, taken);
+		note_decode(taken, encoded_size, st ? result.size() : 0, st);
+		return st;
+	}
 
-	const int size;
-	const int alphabet_base;
-	const unsigned base_size;
-	const unsigned alphabet_base_bits;
-	const unsigned block_size;
-	const uinteger_t::digit alphabet_base_mask;
-	const unsigned padding_size;
-	const char padding;
-	const int flags;
+	template <typename Result>
+	status decode_any(Result& result, const char* encoded, std::size_t encoded_size, path& taken) const {
+		if (byte_aligned()) {
+			taken = path::blocks;
+			return decode_blocks(result, encoded, encoded_size);
+		}
+		taken = path::packed;
+		if (hex_aligned() && decode_hex(result, encoded, encoded_size)) {
+			return {};
+		}
+		std::uint64_t value;
+#ifdef __SIZEOF_INT128__
+		if (encoded_size <= 256 && !block_size && !alphabet_base_bits) {
+			taken = path::fixed;
+			fixed<32 / sizeof(uinteger_t::digit)> words;
+			auto st = (this->*_codec->decode_fixed32)(words, encoded, encoded_size);
+			if (st) {
+				assign_bytes(result, words.data(), words.size());
+			}
+			if (st.code != errc::out_of_range) {
+				return st;
+			}
+		} else
+#endif
+		if (encoded_size <= 64) {
+			taken = path::native;
+			auto st = (this->*_codec->decode_word)(value, encoded, encoded_size);
+			if (st) {
+				// Big-endian bytes without leading zeros; zero is a single zero byte.
+				unsigned char bytes[sizeof(value)];
+				auto n = 0u;
+				do {
+					bytes[sizeof(bytes) - ++n] = static_cast<unsigned char>(value);
+					value >>= 8;
+				} while (value);
+				result.assign(bytes + sizeof(bytes) - n, bytes + sizeof(bytes));
+			}
+			if (st.code != errc::out_of_range) {
+				return st;
+			}
+		}
+		taken = num_path();
+		if (alphabet_base_bits) {
+			return decode_packed(result, encoded, encoded_size);
+		}
+#ifdef __SIZEOF_INT128__
+		if (encoded_size < dc_threshold) {
+			scratch num(encoded_size * bit_length(static_cast<uinteger_t::digit>(alphabet_base - 1)) / uinteger_t::digit_bits + 2, memory_of(result));
+			auto st = decode_limbs(num, encoded, encoded_size);
+			if (st) {
+				store(result, num);
+			}
+			return st;
+		}
+#endif
+		uinteger_t num;
+		auto st = decode_num(num, encoded, encoded_size, memory_of(result));
+		if (st) {
+			assign_bytes(result, num.data(), num.size());
+		}
+		return st;
+	}
 
-	constexpr char chr(unsigned char ord) const {
-		return _chr[ord];
+#ifdef __SIZEOF_INT128__
+	// The decode_fixed loop on as many limbs as the digits need, for byte
+	// results too long for fixed-width words but short of dc_threshold: no
+	// uinteger_t is built, and num needs room for every limb.
+	status decode_limbs(scratch& num, const char* encoded, std::size_t encoded_size) const {
+		auto words = num.data();
+		std::size_t words_size = 0;
+		auto begin = encoded;
+		int sum = 0;
+		int sumsz = 0;
+		auto fold = [&](uinteger_t::digit multiplier, uinteger_t::digit v) {
+			for (std::size_t i = 0; i < words_size; ++i) {
+				auto t = static_cast<double_digit>(words[i]) * multiplier + v;
+				words[i] = static_cast<uinteger_t::digit>(t);
+				v = static_cast<uinteger_t::digit>(t >> uinteger_t::digit_bits);
+			}
+			if (v) {
+				words[words_size++] = v;
+			}
+		};
+
+		auto sz = encoded_size;
+		if (flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		uinteger_t::digit v = 0;
+		unsigned vn = 0;
+		for (; sz; --sz, ++encoded) {
+			auto c = *encoded;
+			if (c == padding) break;
+			auto d = ord(static_cast<int>(c));
+			if (d < 0) continue; // ignored character
+			if (d >= alphabet_base) return {errc::invalid_character, static_cast<std::size_t>(encoded - begin)};
+			v = v * alphabet_base + d;
+			sum += d;
+			++sumsz;
+			if (++vn == word_digits) {
+				fold(word_base, v);
+				v = 0;
+				vn = 0;
+			}
+		}
+		if (vn) {
+			fold(power_of(alphabet_base, vn), v);
+		}
+		num.resize(words_size);
+
+		return decode_trailer(*this, begin, begin + encoded_size, encoded, sz, sum, sumsz, [&] { return num.mod(size); });
 	}
+#endif
 
-	constexpr int ord(unsigned char chr) const {
-		return _ord[chr];
+	template <typename Result>
+	status decode_integer(Result& result, const char* encoded, std::size_t encoded_size, path& taken) const {
+		constexpr bool native = std::numeric_limits<Result>::is_specialized && std::numeric_limits<Result>::digits <= 64;
+		if (native) {
+			taken = path::native;
+			std::uint64_t value;
+			auto st = (this->*_codec->decode_word)(value, encoded, encoded_size);
+			if (st.code != errc::out_of_range) {
+				if (!st) {
+					return st;
+				}
+				if (value > static_cast<std::uint64_t>(std::numeric_limits<Result>::max())) {
+					return {errc::out_of_range, 0};
+				}
+				result = static_cast<Result>(value);
+				return {};
+			}
+		}
+		taken = num_path();
+		uinteger_t num;
+		auto st = decode_num(num, encoded, encoded_size);
+		if (!st) {
+			return st;
+		}
+		if (native && num.bits() > static_cast<std::size_t>(std::numeric_limits<Result>::digits)) {
+			return {errc::out_of_range, 0};
+		}
+		result = static_cast<Result>(num);
+		return {};
+	}
+
+	// Decodes a batch record, right-aligned and zero-filled.
+	void decode_record(unsigned char* record, std::size_t record_size, std::string_view text) const {
+#ifdef __SIZEOF_INT128__
+		if (record_size <= 32 && !block_size && !alphabet_base_bits) {
+			auto st = (this->*(record_size <= 16 ? _codec->decode_record16 : _codec->decode_record32))(record, record_size, text);
+			if (st) {
+				note_decode(path::fixed, text.size(), record_size, st);
+				return;
+			}
+			// Failures go again through the general path, for its error.
+		}
+#endif
+		// Not straight into the record: block decoders size their output
+		// before they validate it.
+		auto place = [&](auto& result) {
+			auto st = decode_bytes(result, text.data(), text.size());
+			if (!st) {
+				throw_error(st, text.data(), text.size());
+			}
+			auto n = result.size();
+			if (n > record_size) span<unsigned char>::overflow();
+			std::memset(record, 0, record_size - n);
+			std::memcpy(record + record_size - n, &result[0], n);
+		};
+		unsigned char buffer[256];
+		if (max_decoded_size(text.size()) <= sizeof(buffer)) {
+			span<unsigned char> result(buffer, sizeof(buffer));
+			place(result);
+		} else {
+			std::string result;
+			place(result);
+		}
+	}
+
+	// decode_bulk() splits the tokens into pieces at token starts, more of
+	// them than there are threads so stealing evens out uneven tokens. Every
+	// piece decodes into a part of its own; the parts are then gathered in
+	// order, also in parallel. Nothing is shared but the pool's queues.
+	bulk decode_tokens(std::string_view tokens, char delimiter, workers* pool) const {
+		if (!tokens.empty() && tokens.back() == delimiter) {
+			tokens.remove_suffix(1);
+		}
+		bulk out;
+		out.offsets.push_back(0);
+		if (tokens.empty()) {
+			return out;
+		}
+		const auto data = tokens.data();
+		const auto size = tokens.size();
+		const std::size_t pieces = pool ? std::max<std::size_t>(1, std::min(pool->size() * 16, size / 4096)) : 1;
+		// The first token start at or after an even split; one past the
+		// delimiter that would follow the last token when there is none.
+		auto start = [&](std::size_t p) -> std::size_t {
+			auto at = size / pieces * p + std::min(p, size % pieces);
+			if (!at) {
+				return 0;
+			}
+			auto d = static_cast<const char*>(std::memchr(data + at - 1, delimiter, size - at + 1));
+			return d ? static_cast<std::size_t>(d - data) + 1 : size + 1;
+		};
+		auto each = [&](std::size_t n, auto&& f) {
+			if (pool) {
+				pool->run(n, f);
+			} else {
+				for (std::size_t i = 0; i < n; ++i) {
+					f(i);
+				}
+			}
+		};
+
+		struct part {
+			std::string bytes;
+			std::vector<std::size_t> ends;
+			std::vector<status> errors;
+		};
+		std::vector<part> parts(pieces);
+		each(pieces, [&](std::size_t p) {
+			auto& part = parts[p];
+			std::string value;
+			for (auto at = start(p), end = start(p + 1); at < end;) {
+				auto d = static_cast<const char*>(std::memchr(data + at, delimiter, end - 1 - at));
+				auto stop = d ? static_cast<std::size_t>(d - data) : end - 1;
+				value.clear();
+				auto st = decode_bytes(value, data + at, stop - at);
+				if (st) {
+					part.bytes.append(value);
+				}
+				part.ends.push_back(part.bytes.size());
+				part.errors.push_back(st);
+				at = stop + 1;
+			}
+		});
+
+		std::vector<std::size_t> first(pieces);
+		std::vector<std::size_t> base(pieces);
+		std::size_t count = 0;
+		std::size_t bytes = 0;
+		for (std::size_t p = 0; p < pieces; ++p) {
+			first[p] = count;
+			base[p] = bytes;
+			count += parts[p].errors.size();
+			bytes += parts[p].bytes.size();
+		}
+		out.bytes.resize(bytes);
+		out.offsets.resize(count + 1);
+		out.errors.resize(count);
+		each(pieces, [&](std::size_t p) {
+			auto& part = parts[p];
+			if (!part.bytes.empty()) {
+				std::memcpy(&out.bytes[base[p]], part.bytes.data(), part.bytes.size());
+			}
+			for (std::size_t j = 0; j < part.errors.size(); ++j) {
+				out.offsets[first[p] + j + 1] = base[p] + part.ends[j];
+				out.errors[first[p] + j] = part.errors[j];
+			}
+		});
+		return out;
+	}
+
+#if defined(BASE_X_INSTRUMENT)
+	// Each thread keeps a block of slots, one per BaseX it used; past the
+	// last but one, all others share the last, under a null codec. Only the
+	// owner writes a slot, so a load and a store add to it; they are atomic
+	// for snapshot() to read them while it does.
+	struct instruments {
+		enum : std::size_t {
+			encodes,
+			decodes,
+			validations,
+			bytes_in,
+			bytes_out,
+			paths,
+			failures = paths + 5,
+			exceptions = failures + 5,
+			values,
+		};
+
+		static constexpr std::size_t capacity = 64;
+
+		struct slot {
+			std::atomic<const BaseX*> codec{nullptr};
+			std::atomic<std::uint64_t> counts[values]{};
+
+			void add(std::size_t i, std::uint64_t n) {
+				counts[i].store(counts[i].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			}
+		};
+
+		struct block {
+			slot slots[capacity];
+			std::atomic<std::size_t> used{0};
+
+			block() {
+				auto& all = registry();
+				std::lock_guard<std::mutex> lk(all.mtx);
+				all.live.push_back(this);
+			}
+
+			~block() {
+				auto& all = registry();
+				std::lock_guard<std::mutex> lk(all.mtx);
+				collect(all.retired);
+				all.live.erase(std::find(all.live.begin(), all.live.end(), this));
+			}
+
+			slot& find(const BaseX* codec) {
+				auto n = used.load(std::memory_order_relaxed);
+				for (std::size_t i = 0; i < n; ++i) {
+					if (slots[i].codec.load(std::memory_order_relaxed) == codec) {
+						return slots[i];
+					}
+				}
+				if (n == capacity) {
+					return slots[capacity - 1];
+				}
+				slots[n].codec.store(n == capacity - 1 ? nullptr : codec, std::memory_order_relaxed);
+				used.store(n + 1, std::memory_order_release);
+				return slots[n];
+			}
+
+			void collect(std::vector<usage>& totals) const {
+				auto n = used.load(std::memory_order_acquire);
+				for (std::size_t i = 0; i < n; ++i) {
+					auto& s = slots[i];
+					auto codec = s.codec.load(std::memory_order_relaxed);
+					auto it = std::find_if(totals.begin(), totals.end(), [&](const usage& u) { return u.codec == codec; });
+					if (it == totals.end()) {
+						it = totals.insert(totals.end(), usage{codec, {}});
+					}
+					auto at = [&](std::size_t j) { return s.counts[j].load(std::memory_order_relaxed); };
+					auto& c = it->counts;
+					c.encodes += at(encodes);
+					c.decodes += at(decodes);
+					c.validations += at(validations);
+					c.bytes_in += at(bytes_in);
+					c.bytes_out += at(bytes_out);
+					for (std::size_t j = 0; j < 5; ++j) {
+						c.paths[j] += at(paths + j);
+						c.failures[j] += at(failures + j);
+					}
+					c.exceptions += at(exceptions);
+				}
+			}
+		};
+
+		// Blocks of running threads, and the sums of those gone.
+		std::mutex mtx;
+		std::vector<block*> live;
+		std::vector<usage> retired;
+
+		static instruments& registry() {
+			static instruments all;
+			return all;
+		}
+	};
+
+	instruments::slot& tally() const {
+		thread_local instruments::block block;
+		thread_local const BaseX* last = nullptr;
+		thread_local instruments::slot* last_slot = nullptr;
+		if (last != this) {
+			last_slot = &block.find(this);
+			last = this;
+		}
+		return *last_slot;
+	}
+
+	void note_encode(path taken, std::size_t in, std::size_t out) const {
+		auto& s = tally();
+		s.add(instruments::encodes, 1);
+		s.add(instruments::bytes_in, in);
+		s.add(instruments::bytes_out, out);
+		s.add(instruments::paths + static_cast<std::size_t>(taken), 1);
+	}
+
+	void note_decode(path taken, std::size_t in, std::size_t out, status st) const {
+		auto& s = tally();
+		s.add(instruments::decodes, 1);
+		s.add(instruments::bytes_in, in);
+		s.add(instruments::paths + static_cast<std::size_t>(taken), 1);
+		if (st) {
+			s.add(instruments::bytes_out, out);
+		} else {
+			s.add(instruments::failures + static_cast<std::size_t>(st.code), 1);
+		}
+	}
+
+	void note_validate(std::size_t in, errc code) const {
+		auto& s = tally();
+		s.add(instruments::validations, 1);
+		s.add(instruments::bytes_in, in);
+		if (code != errc{}) {
+			s.add(instruments::failures + static_cast<std::size_t>(code), 1);
+		}
+	}
+
+	void note_exception() const {
+		tally().add(instruments::exceptions, 1);
+	}
+#else
+	void note_encode(path, std::size_t, std::size_t) const {}
+	void note_decode(path, std::size_t, std::size_t, status) const {}
+	void note_validate(std::size_t, errc) const {}
+	void note_exception() const {}
+#endif
+
+	// The path of the integer encodes that leave native words.
+	path num_path() const {
+		return alphabet_base_bits ? path::packed : path::division;
+	}
+
+	[[noreturn]] void throw_error(status st, char c) const {
+		note_exception();
+		switch (st.code) {
+			case errc::invalid_check:
+				throw std::invalid_argument("Error: Invalid check");
+			case errc::invalid_checksum:
+				throw std::invalid_argument("Error: Invalid checksum");
+			case errc::out_of_range:
+				throw std::out_of_range("Error: Value out of range");
+			default:
+				throw std::invalid_argument("Error: Invalid character: '" + std::string(1, c) + "' at " + std::to_string(st.offset));
+		}
+	}
+
+	// Only an invalid character is quoted: the other errors may sit at the
+	// end of the text (a missing check character) or at its start, and
+	// encoded[st.offset] is not read for them. start is where encoded begins
+	// in a longer text, for the streaming decoder's offsets.
+	[[noreturn]] void throw_error(status st, const char* encoded, std::size_t encoded_size, std::size_t start = 0) const {
+		auto at = st.offset - start;
+		throw_error(st, st.code == errc::invalid_character && st.offset >= start && at < encoded_size ? encoded[at] : '\0');
+	}
+
+	class errc_category : public std::error_category {
+	public:
+		const char* name() const noexcept override {
+			return "base_x";
+		}
+
+		std::string message(int ev) const override {
+			switch (static_cast<errc>(ev)) {
+				case errc::invalid_character:
+					return "Invalid character";
+				case errc::invalid_check:
+					return "Invalid check";
+				case errc::invalid_checksum:
+					return "Invalid checksum";
+				case errc::out_of_range:
+					return "Value out of range";
+			}
+			return "Unknown error";
+		}
+	};
+
+	// Big-endian bytes of a non-negative integer of up to 64 bits, for the
+	// compile-time encode.
+	template <typename T>
+	static constexpr void load_integer(std::array<unsigned char, sizeof(std::uint64_t) + 1>& bytes, T value) {
+		static_assert(sizeof(T) <= sizeof(std::uint64_t), "integers of up to 64 bits");
+		if (value < T(0)) {
+			throw std::out_of_range("Error: Value out of range");
+		}
+		auto v = static_cast<std::uint64_t>(value);
+		for (auto i = sizeof(v); i; --i, v >>= 8) {
+			bytes[i - 1] = static_cast<unsigned char>(v);
+		}
+	}
+
+	// The compile-time codec. Constant expressions cannot use uinteger_t, so
+	// these run the schoolbook conversion on a byte array instead, for the same
+	// text and bytes as encode() and decode(). Errors are thrown, which makes
+	// them compile errors in a constant expression.
+
+	// Encodes the big-endian bytes[0, bytes_size) into out[0, capacity), or
+	// only counts the characters when out is null. bytes is consumed and has
+	// room for one more byte. Integers always take the integer encode, as
+	// encode() does on block padding alphabets.
+	constexpr std::size_t encode_constant(char* out, std::size_t capacity, unsigned char* bytes, std::size_t bytes_size, bool integral) const {
+		std::size_t n = 0;
+		auto put = [&](char c) {
+			if (out) {
+				if (n == capacity) {
+					throw std::length_error("Error: Buffer too small");
+				}
+				out[n] = c;
+			}
+			++n;
+		};
+		if (byte_aligned() && !integral) {
+			std::uint64_t v = 0;
+			unsigned fill = 0;
+			for (std::size_t i = 0; i < bytes_size; ++i) {
+				v = (v << 8) | bytes[i];
+				for (fill += 8; fill >= alphabet_base_bits; fill -= alphabet_base_bits) {
+					put(chr(static_cast<unsigned char>((v >> (fill - alphabet_base_bits)) & alphabet_base_mask)));
+				}
+			}
+			if (fill) {
+				put(chr(static_cast<unsigned char>((v << (alphabet_base_bits - fill)) & alphabet_base_mask)));
+			}
+			while (padding_size && n % padding_size) {
+				put(padding);
+			}
+			return n;
+		}
+		while (bytes_size && !*bytes) {
+			++bytes;
+			--bytes_size;
+		}
+		if (!bytes_size) {
+			put(chr(0));
+			return n;
+		}
+		if (block_size) {
+			// Shifted left so the bit length lands on a block boundary.
+			auto bp = (block_size - bytes_size * 8 % block_size) % block_size;
+			if (bp) {
+				bytes[bytes_size] = 0;
+				unsigned carry = 0;
+				for (std::size_t i = 0; i <= bytes_size; ++i) {
+					unsigned b = bytes[i];
+					bytes[i] = static_cast<unsigned char>(carry | (b >> (8 - bp)));
+					carry = (b << bp) & 0xff;
+				}
+				++bytes_size;
+				if (!*bytes) {
+					++bytes;
+					--bytes_size;
+				}
+			}
+		}
+		int chk = 0;
+		for (std::size_t i = 0; i < bytes_size; ++i) {
+			chk = (chk * 256 + bytes[i]) % size;
+		}
+		// Digits come out least significant first and are reversed in place.
+		int sum = 0;
+		while (bytes_size) {
+			unsigned r = 0;
+			for (std::size_t i = 0; i < bytes_size; ++i) {
+				auto t = (r << 8) | bytes[i];
+				bytes[i] = static_cast<unsigned char>(t / static_cast<unsigned>(alphabet_base));
+				r = t % static_cast<unsigned>(alphabet_base);
+			}
+			while (bytes_size && !*bytes) {
+				++bytes;
+				--bytes_size;
+			}
+			put(chr(static_cast<unsigned char>(r)));
+			sum += static_cast<int>(r);
+		}
+		for (std::size_t i = 0, j = n - 1; out && i < j; ++i, --j) {
+			auto c = out[i];
+			out[i] = out[j];
+			out[j] = c;
+		}
+		while (padding_size && n % padding_size) {
+			put(padding);
+		}
+		if (flags & BaseX::with_check) {
+			put(chr(static_cast<unsigned char>(chk)));
+			sum += chk;
+		}
+		if (flags & BaseX::with_checksum) {
+			auto sz = static_cast<int>(n);
+			sz = (sz + sz / size) % size;
+			sum += sz;
+			sum = (size - sum % size) % size;
+			put(chr(static_cast<unsigned char>(sum)));
+		}
+		return n;
+	}
+
+	// Decodes encoded[0, encoded_size) into out[0, capacity) and returns the
+	// number of bytes. The integer decode builds the value little-endian and
+	// reverses it at the end, so out also needs room for the value before any
+	// block padding shift is undone.
+	constexpr std::size_t decode_constant(unsigned char* out, std::size_t capacity, const char* encoded, std::size_t encoded_size) const {
+		std::size_t n = 0;
+		auto put = [&](unsigned v) {
+			if (n == capacity) {
+				throw std::length_error("Error: Buffer too small");
+			}
+			out[n++] = static_cast<unsigned char>(v);
+		};
+		if (byte_aligned()) {
+			std::uint64_t v = 0;
+			unsigned fill = 0;
+			for (std::size_t i = 0; i < encoded_size && encoded[i] != padding; ++i) {
+				auto d = ord(static_cast<unsigned char>(encoded[i]));
+				if (d < 0) continue; // ignored character
+				if (d >= alphabet_base) {
+					throw std::invalid_argument("Error: Invalid character");
+				}
+				v = (v << alphabet_base_bits) | static_cast<unsigned>(d);
+				fill += alphabet_base_bits;
+				if (fill >= 8) {
+					fill -= 8;
+					put(static_cast<unsigned>(v >> fill));
+				}
+			}
+			return n;
+		}
+
+		int sum = 0;
+		int sumsz = 0;
+		auto sz = encoded_size;
+		if (flags & BaseX::with_checksum) sz = sz ? sz - 1 : 0;
+		if (flags & BaseX::with_check) sz = sz ? sz - 1 : 0;
+
+		std::size_t i = 0;
+		for (; i < sz && encoded[i] != padding; ++i) {
+			auto d = ord(static_cast<unsigned char>(encoded[i]));
+			if (d < 0) continue; // ignored character
+			if (d >= alphabet_base) {
+				throw std::invalid_argument("Error: Invalid character");
+			}
+			sum += d;
+			++sumsz;
+			auto carry = static_cast<unsigned>(d);
+			for (std::size_t j = 0; j < n; ++j) {
+				auto t = out[j] * static_cast<unsigned>(alphabet_base) + carry;
+				out[j] = static_cast<unsigned char>(t);
+				carry = t >> 8;
+			}
+			for (; carry; carry >>= 8) {
+				put(carry);
+			}
+		}
+		if (block_size) {
+			auto shift = (block_size * static_cast<unsigned>(sumsz)) & 7;
+			for (std::size_t j = 0; shift && j < n; ++j) {
+				unsigned next = j + 1 < n ? out[j + 1] : 0;
+				out[j] = static_cast<unsigned char>((out[j] >> shift) | (next << (8 - shift)));
+			}
+		}
+		while (n && !out[n - 1]) {
+			--n;
+		}
+
+		for (; i < sz && encoded[i] == padding; ++i);
+
+		if (flags & BaseX::with_check) {
+			if (i == encoded_size) {
+				throw std::invalid_argument("Error: Invalid check");
+			}
+			auto d = ord(static_cast<unsigned char>(encoded[i]));
+			if (d < 0 || d >= size) {
+				throw std::invalid_argument("Error: Invalid character");
+			}
+			int chk = 0;
+			for (auto j = n; j; --j) {
+				chk = (chk * 256 + out[j - 1]) % size;
+			}
+			if (d != chk) {
+				throw std::invalid_argument("Error: Invalid check");
+			}
+			sum += chk;
+			++sumsz;
+			++i;
+		}
+
+		if (flags & BaseX::with_checksum) {
+			if (i == encoded_size) {
+				throw std::invalid_argument("Error: Invalid checksum");
+			}
+			auto d = ord(static_cast<unsigned char>(encoded[i]));
+			if (d < 0 || d >= size) {
+				throw std::invalid_argument("Error: Invalid character");
+			}
+			sum += d;
+			sum += (sumsz + sumsz / size) % size;
+			if (sum % size) {
+				throw std::invalid_argument("Error: Invalid checksum");
+			}
+		}
+
+		if (!n) {
+			put(0);
+		}
+		for (std::size_t j = 0, k = n - 1; j < k; ++j, --k) {
+			auto b = out[j];
+			out[j] = out[k];
+			out[k] = b;
+		}
+		return n;
 	}
 
 public:
@@ -66,17 +3356,36 @@ public:
 
 	template <std::size_t alphabet_size1, std::size_t extended_size1, std::size_t padding_size1, std::size_t translate_size1>
 	constexpr BaseX(int flgs, const char (&alphabet)[alphabet_size1], const char (&extended)[extended_size1], const char (&padding_string)[padding_size1], const char (&translate)[translate_size1]) :
+		BaseX(flgs, alphabet, extended, padding_string, translate, codec_for<BaseX>, nullptr) { }
+
+private:
+	template <std::size_t alphabet_size1, std::size_t extended_size1, std::size_t padding_size1, std::size_t translate_size1>
+	constexpr BaseX(int flgs, const char (&alphabet)[alphabet_size1], const char (&extended)[extended_size1], const char (&padding_string)[padding_size1], const char (&translate)[translate_size1], const codec& kernels, const char* pairs) :
 		_chr(),
 		_ord(),
+		_ranges(),
 		size(alphabet_size1 - 1 + extended_size1 - 1),
 		alphabet_base(alphabet_size1 - 1),
 		base_size(uinteger_t::base_size(alphabet_base)),
 		alphabet_base_bits(uinteger_t::base_bits(alphabet_base)),
 		block_size((flgs & BaseX::block_padding) ? alphabet_base_bits : 0),
 		alphabet_base_mask(alphabet_base - 1),
+		word_digits(digits_per_word(alphabet_base)),
+		word_base(power_of(alphabet_base, word_digits)),
+		word_shift(leading_zeros(word_base)),
+		word_inverse(reciprocal(word_base << word_shift)),
+		base_shift(bit_length(alphabet_base - 1)),
+		base_inverse(base_reciprocal(alphabet_base)),
+		half_digits(word_digits / 2),
+		half_base(power_of(alphabet_base, half_digits)),
+		half_shift(bit_length(half_base - 1)),
+		half_inverse(base_reciprocal(half_base)),
+		small_inverse(~uinteger_t::digit(0) / alphabet_base + 1),
 		padding_size(padding_size1 - 1),
 		padding(padding_size ? padding_string[0] : '\0'),
-		flags(flgs)
+		flags(flgs),
+		_codec(&kernels),
+		_digrams(pairs)
 	{
 		for (int c = 0; c < 256; ++c) {
 			_chr[c] = 0;
@@ -123,91 +3432,37 @@ public:
 						_ord[(unsigned char)ch - 'a' + 'A'] = cp;
 					}
 				}
-			} else {
-				cp = ncp;
-			}
-		}
-	}
-
-	// Get string representation of value
-	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
-	void encode(Result& result, const uinteger_t& input) const {
-		std::size_t bp = 0;
-		uinteger_t quotient;
-		if (block_size) {
-			bp = ((input.bits() + 7) & 0xf8) % block_size;
-			bp = bp ? (block_size - bp) % block_size : 0;
-			if (bp) {
-				quotient = input << bp;
+			} else {
+				cp = ncp;
 			}
 		}
-		const uinteger_t& num = bp ? quotient : input;
-		auto num_sz = num.size();
-		if (num_sz) {
-			int sum = 0;
-			result.reserve(num_sz * base_size);
-			if (alphabet_base_bits) {
-				std::size_t shift = 0;
-				auto ptr = reinterpret_cast<const uinteger_t::half_digit*>(num.data());
-				uinteger_t::digit v = *ptr++;
-				v <<= uinteger_t::half_digit_bits;
-				for (auto i = num_sz * 2 - 1; i; --i) {
-					v >>= uinteger_t::half_digit_bits;
-					v |= (static_cast<uinteger_t::digit>(*ptr++) << uinteger_t::half_digit_bits);
-					do {
-						auto d = static_cast<int>((v >> shift) & alphabet_base_mask);
-						result.push_back(chr(d));
-						shift += alphabet_base_bits;
-						sum += d;
-					} while (shift <= uinteger_t::half_digit_bits);
-					shift -= uinteger_t::half_digit_bits;
-				}
-				v >>= (shift + uinteger_t::half_digit_bits);
-				while (v) {
-					auto d = static_cast<int>(v & alphabet_base_mask);
-					result.push_back(chr(d));
-					v >>= alphabet_base_bits;
-					sum += d;
-				}
-				auto s = chr(0);
-				auto rit_f = std::find_if(result.rbegin(), result.rend(), [s](const char& c) { return c != s; });
-				result.resize(result.rend() - rit_f); // shrink
+		for (int c = 0, d = 0, n = 0; c < 256; ++c) {
+			auto o = _ord[c];
+			if (o < 0 || o >= alphabet_base || (padding_size && c == static_cast<unsigned char>(padding))) {
+				continue;
+			}
+			if (n && c == _ranges.lo[n - 1] + _ranges.len[n - 1] && o == d + 1 && _ranges.len[n - 1] < 255) {
+				++_ranges.len[n - 1];
+			} else if (n == 8) {
+				_ranges.count = 0;
+				break;
 			} else {
-				uinteger_t uint_base = alphabet_base;
-				if (!bp) {
-					quotient = num;
-				}
-				do {
-					auto r = quotient.divmod(uint_base);
-					auto d = static_cast<int>(r.second);
-					result.push_back(chr(d));
-					quotient = std::move(r.first);
-					sum += d;
-				} while (quotient);
-			}
-			std::reverse(result.begin(), result.end());
-			if (padding_size) {
-				Result p;
-				p.resize((padding_size - (result.size() % padding_size)) % padding_size, padding);
-				result.append(p);
-			}
-			if (flags & BaseX::with_check) {
-				auto chk = static_cast<int>(num % size);
-				result.push_back(chr(chk));
-				sum += chk;
-			}
-			if (flags & BaseX::with_checksum) {
-				auto sz = result.size();
-				sz = (sz + sz / size) % size;
-				sum += sz;
-				sum = (size - sum % size) % size;
-				result.push_back(chr(sum));
+				_ranges.lo[n] = static_cast<unsigned char>(c);
+				_ranges.len[n] = 1;
+				_ranges.delta[n] = static_cast<unsigned char>(o - c);
+				_ranges.count = ++n;
 			}
-		} else {
-			result.push_back(chr(0));
+			d = o;
 		}
 	}
 
+public:
+	// Get string representation of value
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	void encode(Result& result, const uinteger_t& input) const {
+		encode_uinteger(result, input);
+	}
+
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	Result encode(const uinteger_t& num) const {
 		Result result;
@@ -215,27 +3470,41 @@ public:
 		return result;
 	}
 
+	// Native integers up to 64 bits skip uinteger_t: their limbs are built on
+	// the stack and the digits come out of word arithmetic.
+	template <typename Result = std::string, typename T, typename = std::enable_if_t<uinteger_t::is_result<Result>::value && std::is_integral<T>::value && !std::is_same<T, uinteger_t>::value>>
+	void encode(Result& result, T value) const {
+		encode_integral(result, value);
+	}
+
+	template <typename Result = std::string, typename T, typename = std::enable_if_t<uinteger_t::is_result<Result>::value && std::is_integral<T>::value && !std::is_same<T, uinteger_t>::value>>
+	Result encode(T value) const {
+		Result result;
+		encode(result, value);
+		return result;
+	}
+
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	void encode(Result& result, const unsigned char* decoded, std::size_t decoded_size) const {
-		encode(result, uinteger_t(decoded, decoded_size, 256));
+		encode_bytes(result, decoded, decoded_size);
 	}
 
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	Result encode(const unsigned char* decoded, std::size_t decoded_size) const {
 		Result result;
-		encode(result, uinteger_t(decoded, decoded_size, 256));
+		encode(result, decoded, decoded_size);
 		return result;
 	}
 
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	void encode(Result& result, const char* decoded, std::size_t decoded_size) const {
-		encode(result, uinteger_t(decoded, decoded_size, 256));
+		encode(result, reinterpret_cast<const unsigned char*>(decoded), decoded_size);
 	}
 
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	Result encode(const char* decoded, std::size_t decoded_size) const {
 		Result result;
-		encode(result, uinteger_t(decoded, decoded_size, 256));
+		encode(result, decoded, decoded_size);
 		return result;
 	}
 
@@ -263,103 +3532,160 @@ public:
 		return result;
 	}
 
-	void decode(uinteger_t& result, const char* encoded, std::size_t encoded_size) const {
-		result = 0;
-		int sum = 0;
-		int sumsz = 0;
-		int direction = 1;
+#if defined(BASE_X_PMR)
+	// encode() into a std::pmr::string on memory, which backs its scratch
+	// limbs as well, so on a std::pmr::monotonic_buffer_resource a call is a
+	// few pointer bumps and everything is freed with the resource. Any
+	// std::pmr::string or std::pmr::vector passed as Result does the same
+	// with its own resource. The divide-and-conquer conversions of long
+	// values still use uinteger_t, on the heap.
+	std::pmr::string encode(std::string_view binary, memory_resource* memory) const {
+		std::pmr::string result(memory);
+		encode(result, binary.data(), binary.size());
+		return result;
+	}
+#endif
 
-		auto sz = encoded_size;
-		if (flags & BaseX::with_checksum) --sz;
-		if (flags & BaseX::with_check) --sz;
+	// encode() with the divide-and-conquer conversion of long values in
+	// non-power-of-two bases split across pool: both halves of every split
+	// are converted in parallel, and the top splits multiply in parallel too.
+	// The text is the same as encode()'s. Everything else runs on the calling
+	// thread as usual.
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	void encode(Result& result, const uinteger_t& input, workers& pool) const {
+		encode_uinteger(result, input, &pool);
+	}
 
-		int bp = 0;
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	Result encode(const uinteger_t& input, workers& pool) const {
+		Result result;
+		encode(result, input, pool);
+		return result;
+	}
 
-		if (alphabet_base_bits) {
-			for (; sz; --sz, encoded += direction) {
-				auto c = *encoded;
-				if (c == padding) break;
-				auto d = ord(static_cast<int>(c));
-				if (d < 0) continue; // ignored character
-				if (d >= alphabet_base) {
-					throw std::invalid_argument("Error: Invalid character: '" + std::string(1, c) + "' at " + std::to_string(encoded_size - sz));
-				}
-				sum += d;
-				++sumsz;
-				result = (result << alphabet_base_bits) | d;
-				bp += block_size;
-			}
-		} else {
-			uinteger_t uint_base = alphabet_base;
-			for (; sz; --sz, encoded += direction) {
-				auto c = *encoded;
-				if (c == padding) break;
-				auto d = ord(static_cast<int>(c));
-				if (d < 0) continue; // ignored character
-				if (d >= alphabet_base) {
-					throw std::invalid_argument("Error: Invalid character: '" + std::string(1, c) + "' at " + std::to_string(encoded_size - sz));
-				}
-				sum += d;
-				++sumsz;
-				result = (result * uint_base) + d;
-				bp += block_size;
-			}
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	void encode(Result& result, std::string_view binary, workers& pool) const {
+		encode_bytes(result, reinterpret_cast<const unsigned char*>(binary.data()), binary.size(), &pool);
+	}
+
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	Result encode(std::string_view binary, workers& pool) const {
+		Result result;
+		encode(result, binary, pool);
+		return result;
+	}
+
+	// Largest number of characters encode() writes for decoded_size bytes of
+	// input (or an integer that many bytes wide).
+	constexpr std::size_t max_encoded_size(std::size_t decoded_size) const {
+		std::size_t chars = alphabet_base_bits
+			? (decoded_size * 8 + alphabet_base_bits - 1) / alphabet_base_bits
+			: (decoded_size + sizeof(uinteger_t::digit) - 1) / sizeof(uinteger_t::digit) * base_size;
+		if (byte_aligned()) {
+			return padding_size ? (chars + padding_size - 1) / padding_size * padding_size : chars;
+		}
+		if (!chars) {
+			return 1;
 		}
+		if (padding_size) {
+			chars = (chars + padding_size - 1) / padding_size * padding_size;
+		}
+		return chars + ((flags & BaseX::with_check) ? 1 : 0) + ((flags & BaseX::with_checksum) ? 1 : 0);
+	}
+
+	// Encode straight into out[0, capacity) and return the number of
+	// characters written; nothing is allocated. Throws std::length_error when
+	// the text does not fit, which max_encoded_size() rules out.
+	std::size_t encode_to(char* out, std::size_t capacity, const unsigned char* decoded, std::size_t decoded_size) const {
+		span<char> result(out, capacity);
+		encode_bytes(result, decoded, decoded_size);
+		return result.size();
+	}
 
-		for (; sz && *encoded == padding; --sz, ++encoded);
+	std::size_t encode_to(char* out, std::size_t capacity, const char* decoded, std::size_t decoded_size) const {
+		return encode_to(out, capacity, reinterpret_cast<const unsigned char*>(decoded), decoded_size);
+	}
 
-		result >>= (bp & 7);
+	std::size_t encode_to(char* out, std::size_t capacity, std::string_view binary) const {
+		return encode_to(out, capacity, binary.data(), binary.size());
+	}
 
-		if (flags & BaseX::with_check) {
-			auto c = *encoded;
-			auto d = ord(static_cast<int>(c));
-			if (d < 0 || d >= size) {
-				throw std::invalid_argument("Error: Invalid character: '" + std::string(1, c) + "' at " + std::to_string(encoded_size - sz));
-			}
-			auto chk = static_cast<int>(result % size);
-			if (d != chk) {
-				throw std::invalid_argument("Error: Invalid check");
-			}
-			sum += chk;
-			++sumsz;
-			++encoded;
-		}
+	std::size_t encode_to(char* out, std::size_t capacity, const uinteger_t& input) const {
+		span<char> result(out, capacity);
+		encode_uinteger(result, input);
+		return result.size();
+	}
 
-		if (flags & BaseX::with_checksum) {
-			auto c = *encoded;
-			auto d = ord(static_cast<int>(c));
-			if (d < 0 || d >= size) {
-				throw std::invalid_argument("Error: Invalid character: '" + std::string(1, c) + "' at " + std::to_string(encoded_size - sz));
-			}
-			sum += d;
-			sum += (sumsz + sumsz / size) % size;
-			if (sum % size) {
-				throw std::invalid_argument("Error: Invalid checksum");
-			}
+	template <typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, uinteger_t>::value>>
+	std::size_t encode_to(char* out, std::size_t capacity, T value) const {
+		span<char> result(out, capacity);
+		encode_integral(result, value);
+		return result.size();
+	}
+
+	// Decodes like decode() without throwing: failures come back as their
+	// kind and the offset of the offending character, found in the same single
+	// pass, and no message is built. result is unspecified on failure.
+	status try_decode(uinteger_t& result, const char* encoded, std::size_t encoded_size) const {
+		auto st = decode_num(result, encoded, encoded_size);
+#if defined(BASE_X_INSTRUMENT)
+		// bits() walks the result, so only count it when counting.
+		note_decode(num_path(), encoded_size, (result.bits() + 7) / 8, st);
+#endif
+		return st;
+	}
+
+	template <typename Result, typename = typename std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	status try_decode(Result& result, const char* encoded, std::size_t encoded_size) const {
+		return decode_bytes(result, encoded, encoded_size);
+	}
+
+	// Values that do not fit Result are out_of_range instead of being
+	// truncated; results of up to 64 bits are decoded on a native word.
+	template <typename Result, typename = typename std::enable_if_t<std::is_integral<Result>::value>, typename = void>
+	status try_decode(Result& result, const char* encoded, std::size_t encoded_size) const {
+		path taken;
+		auto st = decode_integer(result, encoded, encoded_size, taken);
+		note_decode(taken, encoded_size, sizeof(Result), st);
+		return st;
+	}
+
+	template <typename Result>
+	status try_decode(Result& result, std::string_view encoded) const {
+		return try_decode(result, encoded.data(), encoded.size());
+	}
+
+	void decode(uinteger_t& result, const char* encoded, std::size_t encoded_size) const {
+		auto st = try_decode(result, encoded, encoded_size);
+		if (!st) {
+			throw_error(st, encoded, encoded_size);
 		}
 	}
 
 	template <typename Result, typename = typename std::enable_if_t<uinteger_t::is_result<Result>::value>>
 	void decode(Result& result, const char* encoded, std::size_t encoded_size) const {
-		uinteger_t num;
-		decode(num, encoded, encoded_size);
-		result = num.template str<Result>(256);
+		auto st = decode_bytes(result, encoded, encoded_size);
+		if (!st) {
+			throw_error(st, encoded, encoded_size);
+		}
 	}
 
 	// Decode straight into a native integer Result, reversing the integer encode.
 	// is_result and is_integral are disjoint, so this never collides with the
 	// string-like overload above. Without it the value-returning decode<Integral>
 	// below would have no reference-form to delegate to (it failed to compile).
+	// Values that do not fit Result throw std::out_of_range.
 	template <typename Result, typename = typename std::enable_if_t<std::is_integral<Result>::value>, typename = void>
 	void decode(Result& result, const char* encoded, std::size_t encoded_size) const {
-		uinteger_t num;
-		decode(num, encoded, encoded_size);
-		result = static_cast<Result>(num);
+		auto st = try_decode(result, encoded, encoded_size);
+		if (!st) {
+			throw_error(st, encoded, encoded_size);
+		}
 	}
 
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value or std::is_integral<Result>::value>>
 	Result decode(const char* encoded, std::size_t encoded_size) const {
-		Result result;
+		Result result{};
 		decode(result, encoded, encoded_size);
 		return result;
 	}
@@ -371,7 +3697,7 @@ public:
 
 	template <typename Result = std::string, typename T, std::size_t N, typename = std::enable_if_t<uinteger_t::is_result<Result>::value or std::is_integral<Result>::value>>
 	Result decode(T (&&s)[N]) const {
-		Result result;
+		Result result{};
 		decode(result, s, N - 1);
 		return result;
 	}
@@ -383,19 +3709,226 @@ public:
 
 	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value or std::is_integral<Result>::value>>
 	Result decode(std::string_view encoded) const {
-		Result result;
+		Result result{};
+		decode(result, encoded.data(), encoded.size());
+		return result;
+	}
+
+#if defined(BASE_X_PMR)
+	// decode() into a std::pmr::string on memory, as encode() does.
+	std::pmr::string decode(std::string_view encoded, memory_resource* memory) const {
+		std::pmr::string result(memory);
 		decode(result, encoded.data(), encoded.size());
 		return result;
 	}
+#endif
+
+	// Sets ec to the BaseX::errc of a failure, and returns an empty Result,
+	// instead of throwing. try_decode() also gives the offset.
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value or std::is_integral<Result>::value>>
+	Result decode(const char* encoded, std::size_t encoded_size, std::error_code& ec) const {
+		Result result{};
+		auto st = try_decode(result, encoded, encoded_size);
+		if (st) {
+			ec.clear();
+		} else {
+			ec = st.code;
+			result = Result{};
+		}
+		return result;
+	}
+
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value or std::is_integral<Result>::value>>
+	Result decode(std::string_view encoded, std::error_code& ec) const {
+		return decode<Result>(encoded.data(), encoded.size(), ec);
+	}
+
+	static const std::error_category& category() noexcept {
+		static const errc_category instance;
+		return instance;
+	}
+
+	friend std::error_code make_error_code(errc e) noexcept {
+		return {static_cast<int>(e), category()};
+	}
+
+	// Largest number of bytes decode() writes for encoded_size characters:
+	// each one carries at most base_shift bits.
+	constexpr std::size_t max_decoded_size(std::size_t encoded_size) const {
+		auto bytes = (encoded_size * base_shift + 7) / 8;
+		return bytes || byte_aligned() ? bytes : 1;
+	}
+
+	// Decode straight into out[0, capacity) and return the number of bytes
+	// written, with no intermediate Result. Throws std::length_error when they
+	// do not fit, which max_decoded_size() rules out, and std::invalid_argument
+	// as decode() does.
+	std::size_t decode_to(unsigned char* out, std::size_t capacity, const char* encoded, std::size_t encoded_size) const {
+		span<unsigned char> result(out, capacity);
+		auto st = decode_bytes(result, encoded, encoded_size);
+		if (!st) {
+			throw_error(st, encoded, encoded_size);
+		}
+		return result.size();
+	}
+
+	std::size_t decode_to(unsigned char* out, std::size_t capacity, std::string_view encoded) const {
+		return decode_to(out, capacity, encoded.data(), encoded.size());
+	}
+
+	// Batch encode of count records of record_size bytes stored back to back,
+	// each to the text encode() gives it, with nothing allocated per record.
+	//
+	// This one appends the texts to arena and gives offsets count + 1
+	// entries: text i is arena[offsets[i], offsets[i + 1]).
+	template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+	void encode_batch(Result& arena, std::vector<std::size_t>& offsets, const unsigned char* records, std::size_t record_size, std::size_t count) const {
+		offsets.resize(count + 1);
+		offsets[0] = arena.size();
+		for (std::size_t i = 0; i < count; ++i) {
+			encode_bytes(arena, records + i * record_size, record_size);
+			offsets[i + 1] = arena.size();
+		}
+	}
+
+	// This one writes text i at out + i * stride and its length to
+	// lengths[i]. Throws std::length_error when a text does not fit in
+	// stride characters, which a stride of max_encoded_size(record_size)
+	// rules out.
+	void encode_batch(char* out, std::size_t stride, std::size_t* lengths, const unsigned char* records, std::size_t record_size, std::size_t count) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			lengths[i] = encode_to(out + i * stride, stride, records + i * record_size, record_size);
+		}
+	}
+
+	// Batch decode of count texts into records of record_size bytes stored
+	// back to back, each value right-aligned and zero-filled, as
+	// encode_batch() read them. Records of up to 32 bytes in bases that are
+	// not powers of two are read on limbs sized for the record. Throws as
+	// decode() does at the first bad text, and std::length_error for a value
+	// over record_size bytes.
+	//
+	// Text i is texts[offsets[i], offsets[i + 1]).
+	void decode_batch(unsigned char* records, std::size_t record_size, const char* texts, const std::size_t* offsets, std::size_t count) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			decode_record(records + i * record_size, record_size, std::string_view(texts + offsets[i], offsets[i + 1] - offsets[i]));
+		}
+	}
+
+	// Text i is lengths[i] characters at texts + i * stride.
+	void decode_batch(unsigned char* records, std::size_t record_size, const char* texts, std::size_t stride, const std::size_t* lengths, std::size_t count) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			decode_record(records + i * record_size, record_size, std::string_view(texts + i * stride, lengths[i]));
+		}
+	}
+
+	// Decodes a buffer of tokens separated by delimiter, such as the lines of
+	// a file; a trailing delimiter ends the last token. Failures are not
+	// thrown but kept in the errors of their token, as try_decode() reports
+	// them. With a pool the work is split across its threads.
+	bulk decode_bulk(std::string_view tokens, char delimiter, workers& pool) const {
+		return decode_tokens(tokens, delimiter, &pool);
+	}
+
+	bulk decode_bulk(std::string_view tokens, char delimiter = '\n') const {
+		return decode_tokens(tokens, delimiter, nullptr);
+	}
+
+	// Compile-time encode of a string literal's bytes, or of an integer, into
+	// exactly M characters (encoded_length() gives M). In a constant
+	// expression a wrong M or an invalid input fails to compile.
+	template <std::size_t M, std::size_t N>
+	constexpr std::array<char, M> encode(const char (&decoded)[N]) const {
+		std::array<unsigned char, N> bytes{};
+		for (std::size_t i = 0; i + 1 < N; ++i) {
+			bytes[i] = static_cast<unsigned char>(decoded[i]);
+		}
+		std::array<char, M> result{};
+		if (encode_constant(result.data(), M, bytes.data(), N - 1, false) != M) {
+			throw std::length_error("Error: Wrong encoded length");
+		}
+		return result;
+	}
+
+	template <std::size_t M, typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	constexpr std::array<char, M> encode(T value) const {
+		std::array<unsigned char, sizeof(std::uint64_t) + 1> bytes{};
+		load_integer(bytes, value);
+		std::array<char, M> result{};
+		if (encode_constant(result.data(), M, bytes.data(), sizeof(std::uint64_t), true) != M) {
+			throw std::length_error("Error: Wrong encoded length");
+		}
+		return result;
+	}
+
+	template <std::size_t N>
+	constexpr std::size_t encoded_length(const char (&decoded)[N]) const {
+		std::array<unsigned char, N> bytes{};
+		for (std::size_t i = 0; i + 1 < N; ++i) {
+			bytes[i] = static_cast<unsigned char>(decoded[i]);
+		}
+		return encode_constant(nullptr, 0, bytes.data(), N - 1, false);
+	}
+
+	template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	constexpr std::size_t encoded_length(T value) const {
+		std::array<unsigned char, sizeof(std::uint64_t) + 1> bytes{};
+		load_integer(bytes, value);
+		return encode_constant(nullptr, 0, bytes.data(), sizeof(std::uint64_t), true);
+	}
+
+	// Compile-time decode of a string literal into exactly M bytes
+	// (decoded_length() gives M).
+	template <std::size_t M, std::size_t N>
+	constexpr std::array<char, M> decode(const char (&encoded)[N]) const {
+		std::array<unsigned char, M + 1> bytes{};
+		if (decode_constant(bytes.data(), M + 1, encoded, N - 1) != M) {
+			throw std::length_error("Error: Wrong decoded length");
+		}
+		std::array<char, M> result{};
+		for (std::size_t i = 0; i < M; ++i) {
+			result[i] = static_cast<char>(bytes[i]);
+		}
+		return result;
+	}
+
+	template <std::size_t N>
+	constexpr std::size_t decoded_length(const char (&encoded)[N]) const {
+		// No character carries more than 8 bits.
+		std::array<unsigned char, N + 1> bytes{};
+		return decode_constant(bytes.data(), N + 1, encoded, N - 1);
+	}
 
 	bool is_valid(const char* encoded, std::size_t encoded_size) const {
+		const auto length = encoded_size;
 		int sum = 0;
 		int sumsz = 0;
 		if (flags & BaseX::with_checksum) --sumsz;
+		const bool vectorized = _ranges.count && base_x_simd::get_level() != base_x_simd::level::scalar;
 		for (; encoded_size; --encoded_size, ++encoded) {
+			if (vectorized) {
+				// Runs of digits go to the vector kernels, which stop at
+				// ignored and invalid characters for the loop below.
+				std::size_t valid;
+				if (flags & BaseX::with_checksum) {
+					// Only sum modulo size matters, which also keeps it from overflowing.
+					std::uint64_t run = 0;
+					valid = base_x_simd::checksum(encoded, encoded_size, _ranges, run);
+					if (valid) {
+						sum = static_cast<int>((sum + run) % size);
+						sumsz += static_cast<int>(valid);
+					}
+				} else {
+					valid = base_x_simd::validate(encoded, encoded_size, _ranges);
+				}
+				encoded += valid;
+				encoded_size -= valid;
+				if (!encoded_size) break;
+			}
 			auto d = ord(static_cast<int>(*encoded));
 			if (d < 0) continue; // ignored character
 			if (d >= alphabet_base) {
+				note_validate(length, errc::invalid_character);
 				return false;
 			}
 			sum += d;
@@ -404,9 +3937,11 @@ public:
 		if (flags & BaseX::with_checksum) {
 			sum += (sumsz + sumsz / size) % size;
 			if (sum % size) {
+				note_validate(length, errc::invalid_checksum);
 				return false;
 			}
 		}
+		note_validate(length, errc{});
 		return true;
 	}
 
@@ -418,214 +3953,633 @@ public:
 	bool is_valid(std::string_view encoded) const {
 		return is_valid(encoded.data(), encoded.size());
 	}
+
+	// Push-style streaming encoder for byte-aligned block padding alphabets.
+	// update() appends the characters for every whole block seen so far and
+	// keeps the remaining (fewer than block_bytes) input bytes; finish()
+	// encodes those and the padding. The concatenated output is the same as
+	// encode() of the concatenated input, and the state is constant in size.
+	class encoder {
+		const BaseX& base;
+		unsigned char pending[8];
+		unsigned pending_size;
+		std::size_t written;
+
+	public:
+		explicit encoder(const BaseX& base_) : base(base_), pending(), pending_size(0), written(0) {
+			if (!base.byte_aligned()) {
+				throw std::invalid_argument("Error: Streaming requires a block padding alphabet");
+			}
+		}
+
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void update(Result& result, const unsigned char* decoded, std::size_t decoded_size) {
+			const unsigned bits = base.alphabet_base_bits;
+			const unsigned block_bytes = bits / (bits & -bits);
+			const unsigned block_chars = 8 / (bits & -bits);
+			if (pending_size) {
+				auto n = std::min<std::size_t>(block_bytes - pending_size, decoded_size);
+				std::memcpy(pending + pending_size, decoded, n);
+				pending_size += static_cast<unsigned>(n);
+				decoded += n;
+				decoded_size -= n;
+				if (pending_size < block_bytes) {
+					return;
+				}
+				base.encode_blocks(result, pending, block_bytes, false);
+				written += block_chars;
+				pending_size = 0;
+			}
+			auto whole = decoded_size - decoded_size % block_bytes;
+			base.encode_blocks(result, decoded, whole, false);
+			written += whole / block_bytes * block_chars;
+			pending_size = static_cast<unsigned>(decoded_size - whole);
+			std::memcpy(pending, decoded + whole, pending_size);
+		}
+
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void update(Result& result, const char* decoded, std::size_t decoded_size) {
+			update(result, reinterpret_cast<const unsigned char*>(decoded), decoded_size);
+		}
+
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void update(Result& result, std::string_view binary) {
+			update(result, binary.data(), binary.size());
+		}
+
+		// Flushes the last partial block and the padding, then resets the
+		// encoder so it can start a new stream.
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void finish(Result& result) {
+			const unsigned bits = base.alphabet_base_bits;
+			auto chars = (pending_size * 8 + bits - 1) / bits;
+			base.encode_blocks(result, pending, pending_size, false);
+			written += chars;
+			if (base.padding_size) {
+				result.resize(result.size() + (base.padding_size - written % base.padding_size) % base.padding_size, base.padding);
+			}
+			pending_size = 0;
+			written = 0;
+		}
+	};
+
+	// Push-style streaming decoder, the counterpart of encoder. update()
+	// appends every whole byte decoded so far and carries the leftover bits;
+	// everything after the first padding character is ignored, as in decode().
+	// Invalid character errors report the offset within the whole stream.
+	class decoder {
+		friend class BaseX;
+
+		const BaseX& base;
+		uinteger_t::digit v;
+		unsigned fill;
+		std::size_t offset;
+		bool done;
+
+		template <typename Result>
+		status feed(Result& result, const char* encoded, std::size_t encoded_size) {
+			if (done) {
+				return {};
+			}
+			const unsigned bits = base.alphabet_base_bits;
+			// Only the text before the first padding character is decoded, and
+			// only it is counted when making room.
+			auto padding = static_cast<const char*>(std::memchr(encoded, base.padding, encoded_size));
+			auto size = padding ? static_cast<std::size_t>(padding - encoded) : encoded_size;
+			auto st = base.append_decoded(result, (fill + size * bits) / 8, encoded, size, [&](unsigned char* out, std::size_t& written) -> status {
+				auto first = out;
+				for (std::size_t i = 0; i < size; ++i) {
+					if (!fill) {
+						auto vectorized = base_x_simd::decode(bits, encoded + i, size - i, out, base._ranges);
+						if (vectorized) {
+							i += vectorized;
+							out += vectorized * bits / 8;
+							if (i == size) break;
+						}
+					}
+					auto d = base.ord(static_cast<int>(encoded[i]));
+					if (d < 0) continue; // ignored character
+					if (d >= base.alphabet_base) {
+						written = static_cast<std::size_t>(out - first);
+						return {errc::invalid_character, i};
+					}
+					v = (v << bits) | d;
+					fill += bits;
+					if (fill >= 8) {
+						fill -= 8;
+						*out++ = static_cast<unsigned char>(v >> fill);
+					}
+				}
+				written = static_cast<std::size_t>(out - first);
+				return {};
+			});
+			if (!st) {
+				return {st.code, offset + st.offset};
+			}
+			done = padding != nullptr;
+			offset += encoded_size;
+			return {};
+		}
+
+	public:
+		explicit decoder(const BaseX& base_) : base(base_), v(0), fill(0), offset(0), done(false) {
+			if (!base.byte_aligned()) {
+				throw std::invalid_argument("Error: Streaming requires a block padding alphabet");
+			}
+		}
+
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value || is_span<Result>::value>>
+		void update(Result& result, const char* encoded, std::size_t encoded_size) {
+			auto st = feed(result, encoded, encoded_size);
+			if (!st) {
+				base.throw_error(st, encoded, encoded_size, offset);
+			}
+		}
+
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void update(Result& result, std::string_view encoded) {
+			update(result, encoded.data(), encoded.size());
+		}
+
+		// Ends the stream. Leftover bits short of a byte are dropped, as in
+		// decode(), and the decoder is reset so it can start a new stream.
+		template <typename Result = std::string, typename = std::enable_if_t<uinteger_t::is_result<Result>::value>>
+		void finish(Result&) {
+			v = 0;
+			fill = 0;
+			offset = 0;
+			done = false;
+		}
+	};
+};
+
+namespace std {
+	template <>
+	struct is_error_code_enum<BaseX::errc> : true_type { };
+}
+
+// BaseX's parameters as compile-time constants, named after the members they
+// stand for and computed the same way, for the kernels to fold in.
+template <int Size, int Base, int Flags, char Padding>
+struct BaseX::constants {
+	static constexpr int size = Size;
+	static constexpr int alphabet_base = Base;
+	static constexpr unsigned alphabet_base_bits = uinteger_t::base_bits(Base);
+	static constexpr unsigned block_size = (Flags & BaseX::block_padding) ? alphabet_base_bits : 0;
+	static constexpr uinteger_t::digit alphabet_base_mask = Base - 1;
+	static constexpr unsigned word_digits = digits_per_word(Base);
+	static constexpr uinteger_t::digit word_base = power_of(Base, word_digits);
+	static constexpr unsigned word_shift = leading_zeros(word_base);
+	static constexpr uinteger_t::digit word_inverse = reciprocal(word_base << word_shift);
+	static constexpr unsigned base_shift = bit_length(Base - 1);
+	static constexpr uinteger_t::digit base_inverse = base_reciprocal(Base);
+	static constexpr unsigned half_digits = word_digits / 2;
+	static constexpr uinteger_t::digit half_base = power_of(Base, half_digits);
+	static constexpr unsigned half_shift = bit_length(half_base - 1);
+	static constexpr uinteger_t::digit half_inverse = base_reciprocal(half_base);
+	static constexpr uinteger_t::digit small_inverse = ~uinteger_t::digit(0) / Base + 1;
+	static constexpr char padding = Padding;
+	static constexpr int flags = Flags;
+};
+
+// The characters of every two digits of a power of two alphabet, in text
+// order: pairs[2 * ((hi << Bits) | lo)] holds chr(hi) and chr(lo). Encoders
+// store them two at a time; that is 512 bytes for hex and 8 KiB for base64.
+template <unsigned Bits>
+struct BaseX::digrams {
+	char pairs[2 << (2 * Bits)];
+
+	constexpr explicit digrams(const char* alphabet) : pairs() {
+		for (unsigned p = 0; p < (1u << (2 * Bits)); ++p) {
+			pairs[2 * p] = alphabet[p >> Bits];
+			pairs[2 * p + 1] = alphabet[p & ((1u << Bits) - 1)];
+		}
+	}
+};
+
+// The strings of a BasicBaseX alphabet, as BaseX's constructor takes them:
+// alphabet types derive from this, define alphabet and override whichever of
+// the others they use.
+struct BaseXAlphabet {
+	static constexpr char extended[] = "";
+	static constexpr char padding[] = "";
+	static constexpr char translate[] = "";
+};
+
+// A BaseX whose alphabet and flags are template arguments. Its native word
+// and fixed-width paths are compiled for them: divisions by the base and by
+// the alphabet size turn into multiplications and the check, checksum and
+// padding branches go away. Calls through a plain BaseX reach them too, so
+// the presets below are all BasicBaseX.
+template <typename Alphabet, int Flags = 0>
+class BasicBaseX : public BaseX {
+	// ignore_case only shapes the tables, so it is left out of the constants.
+	using alphabet_constants = BaseX::constants<
+		sizeof(Alphabet::alphabet) - 1 + sizeof(Alphabet::extended) - 1,
+		sizeof(Alphabet::alphabet) - 1,
+		Flags & ~BaseX::ignore_case,
+		Alphabet::padding[0]>;
+
+	// Power of two alphabets up to base64 get digram tables, built here at
+	// compile time.
+	static constexpr unsigned digram_bits = alphabet_constants::alphabet_base_bits <= 6 ? alphabet_constants::alphabet_base_bits : 0;
+	static constexpr BaseX::digrams<digram_bits> digram_table{Alphabet::alphabet};
+
+public:
+	constexpr BasicBaseX() :
+		BaseX(Flags, Alphabet::alphabet, Alphabet::extended, Alphabet::padding, Alphabet::translate, codec_for<alphabet_constants>, digram_bits ? digram_table.pairs : nullptr) { }
 };
 
 // base2
 struct Base2 {
+	struct base2_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "01";
+	};
+	static constexpr BasicBaseX<base2_alphabet> base2_encoder{};
 	static const BaseX& base2() {
-		static constexpr BaseX encoder(0, "01", "", "", "");
-		return encoder;
+		return base2_encoder;
 	}
+	static constexpr BasicBaseX<base2_alphabet, BaseX::with_checksum> base2chk_encoder{};
 	static const BaseX& base2chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "01", "", "", "");
-		return encoder;
+		return base2chk_encoder;
 	}
 };
 
 // base8
 struct Base8 {
+	struct base8_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "01234567";
+	};
+	static constexpr BasicBaseX<base8_alphabet> base8_encoder{};
 	static const BaseX& base8() {
-		static constexpr BaseX encoder(0, "01234567", "", "", "");
-		return encoder;
+		return base8_encoder;
 	}
+	static constexpr BasicBaseX<base8_alphabet, BaseX::with_checksum> base8chk_encoder{};
 	static const BaseX& base8chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "01234567", "", "", "");
-		return encoder;
+		return base8chk_encoder;
 	}
 };
 
 // base11
 struct Base11 {
+	struct base11_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789a";
+	};
+	static constexpr BasicBaseX<base11_alphabet, BaseX::ignore_case> base11_encoder{};
 	static const BaseX& base11() {
-		static constexpr BaseX encoder(BaseX::ignore_case, "0123456789a", "", "", "");
-		return encoder;
+		return base11_encoder;
 	}
+	static constexpr BasicBaseX<base11_alphabet, BaseX::ignore_case | BaseX::with_checksum> base11chk_encoder{};
 	static const BaseX& base11chk() {
-		static constexpr BaseX encoder(BaseX::ignore_case | BaseX::with_checksum, "0123456789a", "", "", "");
-		return encoder;
+		return base11chk_encoder;
 	}
 };
 
 // base16
 struct Base16 {
+	struct base16_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789abcdef";
+	};
+	static constexpr BasicBaseX<base16_alphabet, BaseX::ignore_case> base16_encoder{};
 	static const BaseX& base16() {
-		static constexpr BaseX encoder(BaseX::ignore_case, "0123456789abcdef", "", "", "");
-		return encoder;
+		return base16_encoder;
 	}
+	static constexpr BasicBaseX<base16_alphabet, BaseX::ignore_case | BaseX::with_checksum> base16chk_encoder{};
 	static const BaseX& base16chk() {
-		static constexpr BaseX encoder(BaseX::ignore_case | BaseX::with_checksum, "0123456789abcdef", "", "", "");
-		return encoder;
+		return base16chk_encoder;
 	}
+	struct rfc4648_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEF";
+	};
+	static constexpr BasicBaseX<rfc4648_alphabet> rfc4648_encoder{};
 	static const BaseX& rfc4648() {
-		static constexpr BaseX encoder(0, "0123456789ABCDEF", "", "", "");
-		return encoder;
+		return rfc4648_encoder;
 	}
 };
 
 // base32
 struct Base32 {
+	struct base32_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789abcdefghijklmnopqrstuv";
+	};
+	static constexpr BasicBaseX<base32_alphabet, BaseX::ignore_case> base32_encoder{};
 	static const BaseX& base32() {
-		static constexpr BaseX encoder(BaseX::ignore_case, "0123456789abcdefghijklmnopqrstuv", "", "", "");
-		return encoder;
+		return base32_encoder;
 	}
+	static constexpr BasicBaseX<base32_alphabet, BaseX::ignore_case | BaseX::with_checksum> base32chk_encoder{};
 	static const BaseX& base32chk() {
-		static constexpr BaseX encoder(BaseX::ignore_case | BaseX::with_checksum, "0123456789abcdefghijklmnopqrstuv", "", "", "");
-		return encoder;
+		return base32chk_encoder;
 	}
+	struct crockford_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+		static constexpr char translate[] = "-0O1IL";
+	};
+	static constexpr BasicBaseX<crockford_alphabet, BaseX::ignore_case> crockford_encoder{};
 	static const BaseX& crockford() {
-		static constexpr BaseX encoder(BaseX::ignore_case, "0123456789ABCDEFGHJKMNPQRSTVWXYZ", "", "", "-0O1IL");
-		return encoder;
+		return crockford_encoder;
 	}
+	struct crockfordchk_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+		static constexpr char extended[] = "*~$=U";
+		static constexpr char translate[] = "-0O1IL";
+	};
+	static constexpr BasicBaseX<crockfordchk_alphabet, BaseX::ignore_case | BaseX::with_check> crockfordchk_encoder{};
 	static const BaseX& crockfordchk() {
-		static constexpr BaseX encoder(BaseX::ignore_case | BaseX::with_check, "0123456789ABCDEFGHJKMNPQRSTVWXYZ", "*~$=U", "", "-0O1IL");
-		return encoder;
+		return crockfordchk_encoder;
 	}
+	struct rfc4648_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+		static constexpr char padding[] = "========";
+		static constexpr char translate[] = "\n\r";
+	};
+	static constexpr BasicBaseX<rfc4648_alphabet, BaseX::block_padding> rfc4648_encoder{};
 	static const BaseX& rfc4648() {
-		static constexpr BaseX encoder(BaseX::block_padding, "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567", "", "========", "\n\r");
-		return encoder;
+		return rfc4648_encoder;
 	}
+	struct rfc4648hex_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+		static constexpr char padding[] = "========";
+		static constexpr char translate[] = "\n\r";
+	};
+	static constexpr BasicBaseX<rfc4648hex_alphabet, BaseX::block_padding> rfc4648hex_encoder{};
 	static const BaseX& rfc4648hex() {
-		static constexpr BaseX encoder(BaseX::block_padding, "0123456789ABCDEFGHIJKLMNOPQRSTUV", "", "========", "\n\r");
-		return encoder;
+		return rfc4648hex_encoder;
 	}
 };
 
 // base36
 struct Base36 {
+	struct base36_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+	};
+	static constexpr BasicBaseX<base36_alphabet, BaseX::ignore_case> base36_encoder{};
 	static const BaseX& base36() {
-		static constexpr BaseX encoder(BaseX::ignore_case, "0123456789abcdefghijklmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return base36_encoder;
 	}
+	static constexpr BasicBaseX<base36_alphabet, BaseX::ignore_case | BaseX::with_checksum> base36chk_encoder{};
 	static const BaseX& base36chk() {
-		static constexpr BaseX encoder(BaseX::ignore_case | BaseX::with_checksum, "0123456789abcdefghijklmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return base36chk_encoder;
 	}
 };
 
 // base58
 struct Base58 {
+	struct base58_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuv";
+	};
+	static constexpr BasicBaseX<base58_alphabet> base58_encoder{};
 	static const BaseX& base58() {
-		static constexpr BaseX encoder(0, "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuv", "", "", "");
-		return encoder;
+		return base58_encoder;
 	}
+	static constexpr BasicBaseX<base58_alphabet, BaseX::with_checksum> base58chk_encoder{};
 	static const BaseX& base58chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuv", "", "", "");
-		return encoder;
+		return base58chk_encoder;
 	}
+	struct bitcoin_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+	};
+	static constexpr BasicBaseX<bitcoin_alphabet> bitcoin_encoder{};
 	static const BaseX& bitcoin() {
-		static constexpr BaseX encoder(0, "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return bitcoin_encoder;
 	}
+	static constexpr BasicBaseX<bitcoin_alphabet, BaseX::with_checksum> bitcoinchk_encoder{};
 	static const BaseX& bitcoinchk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return bitcoinchk_encoder;
 	}
+	struct ripple_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+	};
+	static constexpr BasicBaseX<ripple_alphabet> ripple_encoder{};
 	static const BaseX& ripple() {
-		static constexpr BaseX encoder(0, "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz", "", "", "");
-		return encoder;
+		return ripple_encoder;
 	}
+	static constexpr BasicBaseX<ripple_alphabet, BaseX::with_checksum> ripplechk_encoder{};
 	static const BaseX& ripplechk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz", "", "", "");
-		return encoder;
+		return ripplechk_encoder;
 	}
+	struct flickr_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "123456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWXYZ";
+	};
+	static constexpr BasicBaseX<flickr_alphabet> flickr_encoder{};
 	static const BaseX& flickr() {
-		static constexpr BaseX encoder(0, "123456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWXYZ", "", "", "");
-		return encoder;
+		return flickr_encoder;
 	}
+	static constexpr BasicBaseX<flickr_alphabet, BaseX::with_checksum> flickrchk_encoder{};
 	static const BaseX& flickrchk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "123456789abcdefghijkmnopqrstuvwxyzABCDEFGHJKLMNPQRSTUVWXYZ", "", "", "");
-		return encoder;
+		return flickrchk_encoder;
 	}
 };
 
 // base59
 struct Base59 {
+	struct base59_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "23456789abcdefghijklmnopqrstuvwxyzABCDEFGHJKLMNOPQRSTUVWXYZ";
+		static constexpr char translate[] = "l1IO0";
+	};
+	static constexpr BasicBaseX<base59_alphabet> base59_encoder{};
 	static const BaseX& base59() {
-		static constexpr BaseX encoder(0, "23456789abcdefghijklmnopqrstuvwxyzABCDEFGHJKLMNOPQRSTUVWXYZ", "", "", "l1IO0");
-		return encoder;
+		return base59_encoder;
 	}
+	static constexpr BasicBaseX<base59_alphabet, BaseX::with_checksum> base59chk_encoder{};
 	static const BaseX& base59chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "23456789abcdefghijklmnopqrstuvwxyzABCDEFGHJKLMNOPQRSTUVWXYZ", "", "", "l1IO0");
-		return encoder;
+		return base59chk_encoder;
 	}
+	struct dubaluchk_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "zGLUAC2EwdDRrkWBatmscxyYlg6jhP7K53TibenZpMVuvoO9H4XSQq8FfJN";
+		static constexpr char translate[] = "~l1IO0";
+	};
+	static constexpr BasicBaseX<dubaluchk_alphabet, BaseX::with_checksum> dubaluchk_encoder{};
 	static const BaseX& dubaluchk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "zGLUAC2EwdDRrkWBatmscxyYlg6jhP7K53TibenZpMVuvoO9H4XSQq8FfJN", "", "", "~l1IO0");
-		return encoder;
+		return dubaluchk_encoder;
 	}
 };
 
 // base62
 struct Base62 {
+	struct base62_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+	};
+	static constexpr BasicBaseX<base62_alphabet> base62_encoder{};
 	static const BaseX& base62() {
-		static constexpr BaseX encoder(0, "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return base62_encoder;
 	}
+	static constexpr BasicBaseX<base62_alphabet, BaseX::with_checksum> base62chk_encoder{};
 	static const BaseX& base62chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz", "", "", "");
-		return encoder;
+		return base62chk_encoder;
 	}
+	struct inverted_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	};
+	static constexpr BasicBaseX<inverted_alphabet> inverted_encoder{};
 	static const BaseX& inverted() {
-		static constexpr BaseX encoder(0, "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", "", "", "");
-		return encoder;
+		return inverted_encoder;
 	}
+	static constexpr BasicBaseX<inverted_alphabet, BaseX::with_checksum> invertedchk_encoder{};
 	static const BaseX& invertedchk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", "", "", "");
-		return encoder;
+		return invertedchk_encoder;
 	}
 };
 
 // base64
 struct Base64 {
+	struct base64_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	};
+	static constexpr BasicBaseX<base64_alphabet> base64_encoder{};
 	static const BaseX& base64() {
-		static constexpr BaseX encoder(0, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/", "", "", "");
-		return encoder;
+		return base64_encoder;
 	}
+	static constexpr BasicBaseX<base64_alphabet, BaseX::with_checksum> base64chk_encoder{};
 	static const BaseX& base64chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/", "", "", "");
-		return encoder;
+		return base64chk_encoder;
 	}
+	struct url_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+	};
+	static constexpr BasicBaseX<url_alphabet> url_encoder{};
 	static const BaseX& url() {
-		static constexpr BaseX encoder(0, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", "", "", "");
-		return encoder;
+		return url_encoder;
 	}
+	static constexpr BasicBaseX<url_alphabet, BaseX::with_checksum> urlchk_encoder{};
 	static const BaseX& urlchk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", "", "", "");
-		return encoder;
+		return urlchk_encoder;
 	}
+	struct rfc4648_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		static constexpr char padding[] = "====";
+		static constexpr char translate[] = "\n\r";
+	};
+	static constexpr BasicBaseX<rfc4648_alphabet, BaseX::block_padding> rfc4648_encoder{};
 	static const BaseX& rfc4648() {
-		static constexpr BaseX encoder(BaseX::block_padding, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/", "", "====", "\n\r");
-		return encoder;
+		return rfc4648_encoder;
 	}
+	struct rfc4648url_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+		static constexpr char padding[] = "====";
+		static constexpr char translate[] = "\n\r";
+	};
+	static constexpr BasicBaseX<rfc4648url_alphabet, BaseX::block_padding> rfc4648url_encoder{};
 	static const BaseX& rfc4648url() {
-		static constexpr BaseX encoder(BaseX::block_padding, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", "", "====", "\n\r");
-		return encoder;
+		return rfc4648url_encoder;
 	}
+	struct rfc4648url_unpadded_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+		static constexpr char translate[] = "\n\r";
+	};
+	static constexpr BasicBaseX<rfc4648url_unpadded_alphabet, BaseX::block_padding> rfc4648url_unpadded_encoder{};
 	static const BaseX& rfc4648url_unpadded() {
-		static constexpr BaseX encoder(BaseX::block_padding, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", "", "", "\n\r");
-		return encoder;
+		return rfc4648url_unpadded_encoder;
 	}
 };
 
 // base66
 struct Base66 {
+	struct base66_alphabet : BaseXAlphabet {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.!~";
+	};
+	static constexpr BasicBaseX<base66_alphabet> base66_encoder{};
 	static const BaseX& base66() {
-		static constexpr BaseX encoder(0, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.!~", "", "", "");
-		return encoder;
+		return base66_encoder;
 	}
+	static constexpr BasicBaseX<base66_alphabet, BaseX::with_checksum> base66chk_encoder{};
 	static const BaseX& base66chk() {
-		static constexpr BaseX encoder(BaseX::with_checksum, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.!~", "", "", "");
-		return encoder;
+		return base66chk_encoder;
 	}
 };
 
+// Integer literals encoded at compile time, one per BaseNN::baseNN() preset:
+// 519571_base32 is the std::array<char, 4> "frcj" (with
+// using namespace base_x_literals).
+namespace base_x_literals {
+	// The value of an integer literal's characters: decimal, 0x hex, 0b binary
+	// or 0 octal, with ' separators.
+	template <char... Digits>
+	constexpr std::uint64_t integer_literal() {
+		constexpr char digits[] = {Digits..., '\0'};
+		unsigned radix = 10;
+		std::size_t i = 0;
+		if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+			radix = 16;
+			i = 2;
+		} else if (digits[0] == '0' && (digits[1] == 'b' || digits[1] == 'B')) {
+			radix = 2;
+			i = 2;
+		} else if (digits[0] == '0') {
+			radix = 8;
+		}
+		std::uint64_t value = 0;
+		for (; digits[i]; ++i) {
+			auto c = digits[i];
+			if (c == '\'') continue;
+			unsigned d = c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+			if (value > (std::numeric_limits<std::uint64_t>::max() - d) / radix) {
+				throw std::out_of_range("Error: Value out of range");
+			}
+			value = value * radix + d;
+		}
+		return value;
+	}
+
+	template <const auto& base, char... Digits>
+	constexpr auto encode_literal() {
+		constexpr auto value = integer_literal<Digits...>();
+		return base.template encode<base.encoded_length(value)>(value);
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base2() {
+		return encode_literal<Base2::base2_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base8() {
+		return encode_literal<Base8::base8_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base11() {
+		return encode_literal<Base11::base11_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base16() {
+		return encode_literal<Base16::base16_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base32() {
+		return encode_literal<Base32::base32_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base36() {
+		return encode_literal<Base36::base36_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base58() {
+		return encode_literal<Base58::base58_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base59() {
+		return encode_literal<Base59::base59_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base62() {
+		return encode_literal<Base62::base62_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base64() {
+		return encode_literal<Base64::base64_encoder, Digits...>();
+	}
+
+	template <char... Digits>
+	constexpr auto operator""_base66() {
+		return encode_literal<Base66::base66_encoder, Digits...>();
+	}
+}
+
 #endif
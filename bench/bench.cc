@@ -0,0 +1,365 @@
+// Throughput of every factory preset: encode, decode and is_valid over binary
+// inputs from 8 bytes to 1 MiB, in ns/op, MB/s and heap allocations per op.
+//
+// Build (when this repo is the top-level project):
+//   cmake -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target base_x_bench
+//   ./build/base_x_bench [--filter TEXT] [--max-size BYTES] [--min-time SECONDS]
+//                        [--json FILE] [--compare BASELINE] [--threshold PERCENT]
+//                        [--scaling] [--max-ratio RATIO]
+//
+// Sizes are those of the binary data, and MB/s counts those bytes for every
+// operation, so rows compare across presets. The power-of-two alphabets
+// (Base2, Base8, Base16, Base32, Base64 and their RFC 4648 forms) slice bits
+// and stay linear; the rest convert by long division, whose cost per byte
+// grows with the size. A full sweep takes minutes: --filter keeps the presets
+// whose name contains TEXT, and --max-size stops the sizes early.
+//
+// --json writes the results, which is also the format of a baseline.
+// --compare measures again every cell slower than the baseline by more than
+// the threshold (10% by default), keeps its best time, and exits 1 if any
+// cell is still over. Baselines only hold on the machine that recorded them.
+//
+// --scaling times encode and decode at 16 KiB and 64 KiB instead of the
+// sweep, best of three (five for a cell over), and exits 1 if four times the
+// input takes more than RATIO (12 by default) times as long.
+// Divide-and-conquer conversion costs about a multiplication, some nine
+// times for Karatsuba; long division takes sixteen. Unlike a baseline, the
+// ratio holds on any machine.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "base_x.hh"
+
+// Every heap allocation in the process goes through these.
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+struct preset {
+	const char* name;
+	const BaseX& codec;
+};
+
+static const preset presets[] = {
+	{"Base2::base2", Base2::base2()},
+	{"Base2::base2chk", Base2::base2chk()},
+	{"Base8::base8", Base8::base8()},
+	{"Base8::base8chk", Base8::base8chk()},
+	{"Base11::base11", Base11::base11()},
+	{"Base11::base11chk", Base11::base11chk()},
+	{"Base16::base16", Base16::base16()},
+	{"Base16::base16chk", Base16::base16chk()},
+	{"Base16::rfc4648", Base16::rfc4648()},
+	{"Base32::base32", Base32::base32()},
+	{"Base32::base32chk", Base32::base32chk()},
+	{"Base32::crockford", Base32::crockford()},
+	{"Base32::crockfordchk", Base32::crockfordchk()},
+	{"Base32::rfc4648", Base32::rfc4648()},
+	{"Base32::rfc4648hex", Base32::rfc4648hex()},
+	{"Base36::base36", Base36::base36()},
+	{"Base36::base36chk", Base36::base36chk()},
+	{"Base58::base58", Base58::base58()},
+	{"Base58::base58chk", Base58::base58chk()},
+	{"Base58::bitcoin", Base58::bitcoin()},
+	{"Base58::bitcoinchk", Base58::bitcoinchk()},
+	{"Base58::ripple", Base58::ripple()},
+	{"Base58::ripplechk", Base58::ripplechk()},
+	{"Base58::flickr", Base58::flickr()},
+	{"Base58::flickrchk", Base58::flickrchk()},
+	{"Base59::base59", Base59::base59()},
+	{"Base59::base59chk", Base59::base59chk()},
+	{"Base59::dubaluchk", Base59::dubaluchk()},
+	{"Base62::base62", Base62::base62()},
+	{"Base62::base62chk", Base62::base62chk()},
+	{"Base62::inverted", Base62::inverted()},
+	{"Base62::invertedchk", Base62::invertedchk()},
+	{"Base64::base64", Base64::base64()},
+	{"Base64::base64chk", Base64::base64chk()},
+	{"Base64::url", Base64::url()},
+	{"Base64::urlchk", Base64::urlchk()},
+	{"Base64::rfc4648", Base64::rfc4648()},
+	{"Base64::rfc4648url", Base64::rfc4648url()},
+	{"Base64::rfc4648url_unpadded", Base64::rfc4648url_unpadded()},
+	{"Base66::base66", Base66::base66()},
+	{"Base66::base66chk", Base66::base66chk()},
+};
+
+static const std::size_t sizes[] = {8, 64, 512, 4096, 32768, 262144, 1048576};
+
+struct result {
+	const char* preset;
+	const char* op;
+	std::size_t size;
+	double ns;      // per op
+	double mbps;    // binary bytes per second, in millions
+	double allocs;  // per op
+};
+
+// Keeps the results of the timed calls alive.
+static volatile std::size_t sink;
+
+// Runs f in doubling batches until min_time has passed. A first call that
+// takes that long on its own is the measurement.
+template <typename F>
+static result measure(const char* name, const char* op, std::size_t size, double min_time, F&& f) {
+	using clock = std::chrono::steady_clock;
+	std::size_t iterations = 0;
+	std::size_t batch = 1;
+	std::size_t before = allocations.load();
+	auto start = clock::now();
+	double elapsed;
+	bool warm = false;
+	for (;;) {
+		for (std::size_t i = 0; i < batch; ++i) {
+			f();
+		}
+		iterations += batch;
+		elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		if (elapsed >= min_time) {
+			break;
+		}
+		if (!warm) {
+			// That one warmed up the caches; start over.
+			warm = true;
+			iterations = 0;
+			before = allocations.load();
+			start = clock::now();
+		} else {
+			batch *= 2;
+		}
+	}
+	double ns = elapsed * 1e9 / iterations;
+	return {name, op, size, ns, size * 1e3 / ns, static_cast<double>(allocations.load() - before) / iterations};
+}
+
+// The input of a cell, and its encoding for decode and is_valid.
+struct inputs {
+	std::string data;
+	std::string encoded;
+
+	inputs(const BaseX& codec, std::size_t size) : data(size, '\0') {
+		unsigned x = 12345;
+		for (auto& c : data) {
+			x = x * 1103515245 + 12345;
+			c = static_cast<char>(x >> 16);
+		}
+		encoded = codec.encode(data);
+	}
+};
+
+static const char* const ops[] = {"encode", "decode", "is_valid"};
+
+static result run(const preset& p, const char* op, const inputs& in, double min_time) {
+	auto size = in.data.size();
+	if (!std::strcmp(op, "encode")) {
+		return measure(p.name, op, size, min_time, [&] { sink = p.codec.encode(in.data).size(); });
+	}
+	if (!std::strcmp(op, "decode")) {
+		return measure(p.name, op, size, min_time, [&] { sink = p.codec.decode(in.encoded).size(); });
+	}
+	return measure(p.name, op, size, min_time, [&] { sink = p.codec.is_valid(in.encoded); });
+}
+
+static std::string key(const std::string& preset, const std::string& op, std::size_t size) {
+	return preset + " " + op + " " + std::to_string(size);
+}
+
+static void write_json(const char* path, const std::vector<result>& results) {
+	std::FILE* f = std::fopen(path, "w");
+	if (!f) {
+		std::perror(path);
+		std::exit(2);
+	}
+	std::fprintf(f, "{\"results\": [\n");
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		auto& r = results[i];
+		std::fprintf(f, "  {\"preset\": \"%s\", \"op\": \"%s\", \"bytes\": %zu, \"ns\": %.1f, \"mbps\": %.1f, \"allocs\": %.2f}%s\n",
+			r.preset, r.op, r.size, r.ns, r.mbps, r.allocs, i + 1 < results.size() ? "," : "");
+	}
+	std::fprintf(f, "]}\n");
+	std::fclose(f);
+}
+
+// Reads what write_json() writes, one result per line, into ns by key().
+static std::map<std::string, double> read_json(const char* path) {
+	std::ifstream f(path);
+	if (!f) {
+		std::perror(path);
+		std::exit(2);
+	}
+	auto field = [](const std::string& line, const char* name) {
+		auto at = line.find(std::string("\"") + name + "\": ");
+		if (at == std::string::npos) {
+			return std::string();
+		}
+		at += std::strlen(name) + 4;
+		if (line[at] == '"') {
+			return line.substr(at + 1, line.find('"', at + 1) - at - 1);
+		}
+		return line.substr(at, line.find_first_of(",}", at) - at);
+	};
+	std::map<std::string, double> baseline;
+	for (std::string line; std::getline(f, line);) {
+		auto preset = field(line, "preset");
+		if (!preset.empty()) {
+			baseline[key(preset, field(line, "op"), std::stoull(field(line, "bytes")))] = std::stod(field(line, "ns"));
+		}
+	}
+	return baseline;
+}
+
+static const char* const scaling_ops[] = {"encode", "decode"};
+
+static int scaling(const char* filter, double min_time, double max_ratio) {
+	const std::size_t small_size = 16384;
+	const std::size_t large_size = 4 * small_size;
+	std::printf("%-30s %-8s %14s %14s %8s\n", "preset", "op", "16 KiB ns/op", "64 KiB ns/op", "ratio");
+	std::size_t checked = 0;
+	std::size_t failed = 0;
+	for (auto& p : presets) {
+		if (!std::strstr(p.name, filter)) {
+			continue;
+		}
+		inputs small(p.codec, small_size);
+		inputs large(p.codec, large_size);
+		for (auto op : scaling_ops) {
+			double ns[2] = {1e300, 1e300};
+			for (int i = 0; i < 3 || (i < 5 && ns[1] > max_ratio * ns[0]); ++i) {
+				ns[0] = std::min(ns[0], run(p, op, small, min_time).ns);
+				ns[1] = std::min(ns[1], run(p, op, large, min_time).ns);
+			}
+			auto ratio = ns[1] / ns[0];
+			++checked;
+			if (ratio > max_ratio) {
+				++failed;
+			}
+			std::printf("%-30s %-8s %14.1f %14.1f %8.2f%s\n", p.name, op, ns[0], ns[1], ratio, ratio > max_ratio ? "  TOO SLOW" : "");
+			std::fflush(stdout);
+		}
+	}
+	std::printf("%zu of %zu cells over %.1fx\n", failed, checked, max_ratio);
+	return failed ? 1 : 0;
+}
+
+static void usage(const char* argv0) {
+	std::fprintf(stderr, "usage: %s [--filter TEXT] [--max-size BYTES] [--min-time SECONDS]\n"
+		"       [--json FILE] [--compare BASELINE] [--threshold PERCENT]\n"
+		"       [--scaling] [--max-ratio RATIO]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+	const char* filter = "";
+	std::size_t max_size = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+	double min_time = 0.1;
+	const char* json = nullptr;
+	const char* compare = nullptr;
+	double threshold = 10;
+	bool scale = false;
+	double max_ratio = 12;
+	for (int i = 1; i < argc; ++i) {
+		auto arg = std::string(argv[i]);
+		if (arg == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (arg == "--max-size" && i + 1 < argc) {
+			max_size = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--min-time" && i + 1 < argc) {
+			min_time = std::strtod(argv[++i], nullptr);
+		} else if (arg == "--json" && i + 1 < argc) {
+			json = argv[++i];
+		} else if (arg == "--compare" && i + 1 < argc) {
+			compare = argv[++i];
+		} else if (arg == "--threshold" && i + 1 < argc) {
+			threshold = std::strtod(argv[++i], nullptr);
+		} else if (arg == "--scaling") {
+			scale = true;
+		} else if (arg == "--max-ratio" && i + 1 < argc) {
+			max_ratio = std::strtod(argv[++i], nullptr);
+		} else {
+			usage(argv[0]);
+			return arg == "--help" ? 0 : 2;
+		}
+	}
+
+	if (scale) {
+		return scaling(filter, min_time, max_ratio);
+	}
+
+	// Read first, so a bad path fails before the sweep.
+	std::map<std::string, double> baseline;
+	if (compare) {
+		baseline = read_json(compare);
+	}
+
+	std::printf("%-30s %-8s %8s %14s %10s %10s\n", "preset", "op", "bytes", "ns/op", "MB/s", "allocs/op");
+	std::vector<result> results;
+	for (auto& p : presets) {
+		if (!std::strstr(p.name, filter)) {
+			continue;
+		}
+		for (auto size : sizes) {
+			if (size > max_size) {
+				break;
+			}
+			inputs in(p.codec, size);
+			for (auto op : ops) {
+				auto r = run(p, op, in, min_time);
+				std::printf("%-30s %-8s %8zu %14.1f %10.1f %10.2f\n", r.preset, r.op, r.size, r.ns, r.mbps, r.allocs);
+				std::fflush(stdout);
+				results.push_back(r);
+			}
+		}
+	}
+
+	if (json) {
+		write_json(json, results);
+	}
+	if (!compare) {
+		return 0;
+	}
+
+	std::size_t compared = 0;
+	std::size_t regressed = 0;
+	std::printf("\ncompared to %s, threshold +%.0f%%:\n", compare, threshold);
+	for (auto& r : results) {
+		auto it = baseline.find(key(r.preset, r.op, r.size));
+		if (it == baseline.end()) {
+			continue;
+		}
+		++compared;
+		auto limit = it->second * (1 + threshold / 100);
+		auto ns = r.ns;
+		for (int retry = 0; retry < 2 && ns > limit; ++retry) {
+			auto& p = *std::find_if(std::begin(presets), std::end(presets), [&](const preset& q) { return !std::strcmp(q.name, r.preset); });
+			ns = std::min(ns, run(p, r.op, inputs(p.codec, r.size), min_time).ns);
+		}
+		if (ns > limit) {
+			++regressed;
+			std::printf("  REGRESSED %-30s %-8s %8zu %14.1f ns/op vs %.1f (%+.1f%%)\n", r.preset, r.op, r.size, ns, it->second, (ns / it->second - 1) * 100);
+		}
+	}
+	std::printf("%zu of %zu cells regressed\n", regressed, compared);
+	return regressed ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+// Heap allocations per call of every factory preset, against fixed bounds:
+// none for is_valid, encode_to, decode_to and integer decodes, one, the
+// result's, for encode and decode, and none for either on a memory resource.
+// Build: c++ -std=c++17 -I.. allocations.cc -o allocations && ./allocations
+//
+// Only calls that stay off uinteger_t arithmetic are held to a bound, since
+// how often that allocates is up to uinteger_t: non-power-of-two decodes of
+// values longer than the fixed-width words without __int128 (8 bytes), and
+// divide-and-conquer conversions, which start past the sizes below. A
+// temporary uinteger_t, std::string or scratch buffer creeping into any
+// other path fails here. A decode that fails on a bad character allocates
+// nothing, however long the token. A long decode on an arena is held to two
+// fewer allocations than the same decode to a std::string: its result and
+// its digit buffer.
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "base_x.hh"
+
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+struct preset {
+	const char* name;
+	const BaseX& codec;
+	bool power_of_two;
+};
+
+static const preset presets[] = {
+	{"Base2::base2", Base2::base2(), true},
+	{"Base2::base2chk", Base2::base2chk(), true},
+	{"Base8::base8", Base8::base8(), true},
+	{"Base8::base8chk", Base8::base8chk(), true},
+	{"Base11::base11", Base11::base11(), false},
+	{"Base11::base11chk", Base11::base11chk(), false},
+	{"Base16::base16", Base16::base16(), true},
+	{"Base16::base16chk", Base16::base16chk(), true},
+	{"Base16::rfc4648", Base16::rfc4648(), true},
+	{"Base32::base32", Base32::base32(), true},
+	{"Base32::base32chk", Base32::base32chk(), true},
+	{"Base32::crockford", Base32::crockford(), true},
+	{"Base32::crockfordchk", Base32::crockfordchk(), true},
+	{"Base32::rfc4648", Base32::rfc4648(), true},
+	{"Base32::rfc4648hex", Base32::rfc4648hex(), true},
+	{"Base36::base36", Base36::base36(), false},
+	{"Base36::base36chk", Base36::base36chk(), false},
+	{"Base58::base58", Base58::base58(), false},
+	{"Base58::base58chk", Base58::base58chk(), false},
+	{"Base58::bitcoin", Base58::bitcoin(), false},
+	{"Base58::bitcoinchk", Base58::bitcoinchk(), false},
+	{"Base58::ripple", Base58::ripple(), false},
+	{"Base58::ripplechk", Base58::ripplechk(), false},
+	{"Base58::flickr", Base58::flickr(), false},
+	{"Base58::flickrchk", Base58::flickrchk(), false},
+	{"Base59::base59", Base59::base59(), false},
+	{"Base59::base59chk", Base59::base59chk(), false},
+	{"Base59::dubaluchk", Base59::dubaluchk(), false},
+	{"Base62::base62", Base62::base62(), false},
+	{"Base62::base62chk", Base62::base62chk(), false},
+	{"Base62::inverted", Base62::inverted(), false},
+	{"Base62::invertedchk", Base62::invertedchk(), false},
+	{"Base64::base64", Base64::base64(), true},
+	{"Base64::base64chk", Base64::base64chk(), true},
+	{"Base64::url", Base64::url(), true},
+	{"Base64::urlchk", Base64::urlchk(), true},
+	{"Base64::rfc4648", Base64::rfc4648(), true},
+	{"Base64::rfc4648url", Base64::rfc4648url(), true},
+	{"Base64::rfc4648url_unpadded", Base64::rfc4648url_unpadded(), true},
+	{"Base66::base66", Base66::base66(), false},
+	{"Base66::base66chk", Base66::base66chk(), false},
+};
+
+static const std::size_t sizes[] = {1, 8, 16, 32, 64, 128};
+
+#ifdef __SIZEOF_INT128__
+static const std::size_t decode_size = 128;
+#else
+static const std::size_t decode_size = 8;
+#endif
+
+static std::size_t failures = 0;
+
+#if defined(BASE_X_PMR)
+// Runs f on an arena that cannot fall back to the heap.
+template <typename F>
+static void on_arena(F&& f) {
+	static char buffer[1 << 16];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	f(&arena);
+}
+#endif
+
+// Calls f once to warm up, then again, and returns the second call's
+// allocations.
+template <typename F>
+static std::size_t count(F&& f) {
+	f();
+	auto before = allocations.load();
+	f();
+	return allocations.load() - before;
+}
+
+template <typename F>
+static void check(const preset& p, const char* op, std::size_t size, std::size_t bound, F&& f) {
+	auto n = count(f);
+	if (n > bound) {
+		++failures;
+		std::printf("FAILED %-30s %-10s %4zu bytes: %zu allocations, expected at most %zu\n", p.name, op, size, n, bound);
+	}
+}
+
+int main() {
+	std::size_t checked = 0;
+	for (auto& p : presets) {
+		auto& codec = p.codec;
+		for (auto size : sizes) {
+			std::string data(size, '\0');
+			unsigned x = 12345;
+			for (auto& c : data) {
+				x = x * 1103515245 + 12345;
+				c = static_cast<char>(x >> 16);
+			}
+			auto encoded = codec.encode(data);
+			char text[1200];
+			unsigned char bytes[sizeof(text)];
+
+			check(p, "encode", size, 1, [&] { codec.encode(data); });
+			check(p, "encode_to", size, 0, [&] { codec.encode_to(text, sizeof(text), data); });
+			check(p, "is_valid", size, 0, [&] { codec.is_valid(encoded); });
+			checked += 3;
+			if (p.power_of_two || size <= decode_size) {
+				check(p, "decode", size, 1, [&] { codec.decode(encoded); });
+				check(p, "decode_to", size, 0, [&] { codec.decode_to(bytes, sizeof(bytes), encoded); });
+				checked += 2;
+			}
+#if defined(BASE_X_PMR)
+			check(p, "pmr encode", size, 0, [&] { on_arena([&](std::pmr::memory_resource* arena) { codec.encode(data, arena); }); });
+			checked += 1;
+			if (p.power_of_two || size <= decode_size) {
+				check(p, "pmr decode", size, 0, [&] { on_arena([&](std::pmr::memory_resource* arena) { codec.decode(encoded, arena); }); });
+				checked += 1;
+			}
+#endif
+		}
+
+		// A bad character just before the last two of a token: everything
+		// before it has been read when the decode fails.
+		for (auto size : {std::size_t(45), std::size_t(1500)}) {
+#ifndef __SIZEOF_INT128__
+			if (!p.power_of_two && size < 512) {
+				continue;
+			}
+#endif
+			auto token = codec.encode(std::string(size, '\x5a'));
+			token.insert(token.size() - 2, "\x7f");
+			check(p, "failure", size, 0, [&] {
+				std::string result;
+				if (codec.try_decode(result, token).code != BaseX::errc::invalid_character) {
+					std::abort();
+				}
+			});
+			checked += 1;
+		}
+
+		auto number = codec.encode(0x0123456789abcdefULL);
+		check(p, "encode", 8, 1, [&] { codec.encode(0x0123456789abcdefULL); });
+		check(p, "decode", 8, 0, [&] { codec.decode<std::uint64_t>(number); });
+		checked += 2;
+	}
+
+#if defined(BASE_X_PMR)
+	// Past 63 limbs the scratch buffer leaves the stack, for the arena.
+	const preset base64{"Base64::base64", Base64::base64(), true};
+	std::string data(4096, '\x5a');
+	auto encoded = base64.codec.encode(data);
+	check(base64, "pmr encode", data.size(), 0, [&] { on_arena([&](std::pmr::memory_resource* arena) { base64.codec.encode(data, arena); }); });
+	check(base64, "pmr decode", data.size(), 0, [&] { on_arena([&](std::pmr::memory_resource* arena) { base64.codec.decode(encoded, arena); }); });
+	checked += 2;
+
+	// Past dc_threshold (512) digits a decode gathers its digit values for
+	// divide-and-conquer, in a buffer that must come from the arena as well.
+	const preset base58{"Base58::base58", Base58::base58(), false};
+	std::string value(1024, '\xa5');
+	auto digits = base58.codec.encode(value);
+	auto heap = count([&] { base58.codec.decode(digits); });
+	check(base58, "pmr decode", value.size(), heap - 2, [&] { on_arena([&](std::pmr::memory_resource* arena) { base58.codec.decode(digits, arena); }); });
+	checked += 1;
+#endif
+
+	std::printf("%zu of %zu calls over their allocation bound\n", failures, checked);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 German Mendez Bravo (Kronuz) @ german dot mb at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+// A target of its own: BaseX must be built with or without the counters in
+// every translation unit of a program, and the other tests run without them.
+#define BASE_X_INSTRUMENT
+#include "base_x.hh"
+
+
+static BaseX::counters counts_of(const BaseX& codec) {
+	for (auto& u : BaseX::snapshot()) {
+		if (u.codec == &codec) {
+			return u.counts;
+		}
+	}
+	return {};
+}
+
+TEST(instrument, Counters) {
+	auto& b58 = Base58::base58chk();
+	auto& b64 = Base64::rfc4648();
+	auto before = counts_of(b58);
+	auto before64 = counts_of(b64);
+
+	auto word = b58.encode("hello");
+	auto id = b58.encode(std::string(16, '\x5a'));
+	auto text = b58.encode(std::string(100, '\x5a'));
+	EXPECT_EQ(b58.decode(word), "hello");
+	EXPECT_EQ(b58.decode<std::uint32_t>(b58.encode(519571)), 519571u);
+	EXPECT_TRUE(b58.is_valid(text));
+	EXPECT_FALSE(b58.is_valid("abc!"));
+	auto bad = word;
+	bad[0] = bad[0] == '2' ? '3' : '2';
+	EXPECT_THROW(b58.decode(bad), std::invalid_argument);
+	std::thread([&] { b58.encode("hello"); }).join();
+	EXPECT_EQ(b64.decode(b64.encode("foobar")), "foobar");
+
+	auto after = counts_of(b58);
+	EXPECT_EQ(after.encodes - before.encodes, 5u);
+	EXPECT_EQ(after.decodes - before.decodes, 3u);
+	EXPECT_EQ(after.validations - before.validations, 2u);
+	EXPECT_EQ(after.bytes_in - before.bytes_in, 5 + 16 + 100 + 4 + 5 + word.size() * 2 + b58.encode(519571).size() + text.size() + 4);
+	auto native = static_cast<std::size_t>(BaseX::path::native);
+	auto fixed = static_cast<std::size_t>(BaseX::path::fixed);
+	auto division = static_cast<std::size_t>(BaseX::path::division);
+#ifdef __SIZEOF_INT128__
+	EXPECT_EQ(after.paths[native] - before.paths[native], 4u);
+	EXPECT_EQ(after.paths[fixed] - before.paths[fixed], 3u);
+	EXPECT_EQ(after.paths[division] - before.paths[division], 1u);
+#else
+	EXPECT_EQ(after.paths[native] - before.paths[native], 6u);
+	EXPECT_EQ(after.paths[fixed] - before.paths[fixed], 0u);
+	EXPECT_EQ(after.paths[division] - before.paths[division], 2u);
+#endif
+	auto checksum = static_cast<std::size_t>(BaseX::errc::invalid_checksum);
+	auto character = static_cast<std::size_t>(BaseX::errc::invalid_character);
+	EXPECT_EQ(after.failures[checksum] - before.failures[checksum], 1u);
+	EXPECT_EQ(after.failures[character] - before.failures[character], 1u);
+	EXPECT_EQ(after.exceptions - before.exceptions, 1u);
+
+	auto after64 = counts_of(b64);
+	auto blocks = static_cast<std::size_t>(BaseX::path::blocks);
+	EXPECT_EQ(after64.paths[blocks] - before64.paths[blocks], 2u);
+	EXPECT_EQ(after64.bytes_out - before64.bytes_out, 8u + 6u);
+}
@@ -38,6 +38,32 @@ TEST(UUID, Encode) {
 	EXPECT_EQ(Base58::base58().encode("\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256"), "QetBu0Dh1m5ReTNeg8BI0k");
 }
 
+TEST(UUID, FixedWidth) {
+	// 128 and 256-bit keys take a fixed-width path; it must agree with the
+	// uinteger_t one, leading zero bytes, check characters and all.
+	std::string data;
+	unsigned x = 54321;
+	for (int i = 0; i < 32; ++i) {
+		x = x * 1103515245 + 12345;
+		data.push_back(static_cast<char>(x >> 16));
+	}
+	std::vector<std::string> inputs = {std::string(16, '\xff'), std::string(32, '\xff'), std::string(16, '\0') + '\1'};
+	for (std::size_t sz = 9; sz <= 32; ++sz) {
+		inputs.push_back(data.substr(0, sz));
+		inputs.push_back(std::string(sz / 2, '\0') + data.substr(0, sz - sz / 2));
+	}
+	for (auto base : {&Base62::base62(), &Base58::bitcoin(), &Base36::base36(), &Base11::base11(), &Base62::base62chk(), &Base58::bitcoinchk()}) {
+		for (auto& input : inputs) {
+			uinteger_t value(input.data(), input.size(), 256);
+			auto encoded = base->encode(input);
+			EXPECT_EQ(encoded, base->encode(value));
+			EXPECT_EQ(base->decode(encoded), value.str(256));
+		}
+	}
+	// Text that overflows 256 bits still decodes.
+	EXPECT_EQ(Base62::base62().decode<uinteger_t>(std::string(44, 'z')), Base62::base62().decode<uinteger_t>(std::string(43, 'z')) * 62 + 61);
+}
+
 TEST(BaseX, checksums) {
 	EXPECT_EQ(Base64::base64().encode("Hello world!"), "SGVsbG8gd29ybGQh");
 	EXPECT_EQ(Base64::base64chk().encode("Hello world!"), "SGVsbG8gd29ybGQhG");
@@ -357,3 +383,636 @@ TEST(base58, Tests) {
 	EXPECT_EQ(test_base58.encode(uinteger_t("78ff9a0e56f9e88dc1cd654b40d019", 16)), "4PLggs66qAdbmZgkaPihe");
 	EXPECT_EQ(test_base58.encode(uinteger_t("6d691bdd736346aa5a0a95b373b2ab", 16)), "44Y6qTgSvRMkdqpQ5ufkN");
 }
+
+TEST(base58, LongValues) {
+	// Long values go through divide-and-conquer; check them against plain
+	// one-digit-at-a-time long division.
+	static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+	std::string data;
+	unsigned x = 12345;
+	for (int i = 0; i < 4096; ++i) {
+		x = x * 1103515245 + 12345;
+		data.push_back(static_cast<char>(x >> 16));
+	}
+	for (auto sz : {500, 1000, 4096}) {
+		auto input = data.substr(0, sz);
+		std::string expected;
+		uinteger_t quotient(input.data(), input.size(), 256);
+		do {
+			auto r = quotient.divmod(58);
+			expected.push_back(alphabet[static_cast<int>(r.second)]);
+			quotient = std::move(r.first);
+		} while (quotient);
+		std::reverse(expected.begin(), expected.end());
+
+		auto encoded = Base58::bitcoin().encode(input);
+		EXPECT_EQ(encoded, expected);
+		EXPECT_EQ(Base58::bitcoin().decode(encoded), input);
+		EXPECT_EQ(Base58::bitcoinchk().decode(Base58::bitcoinchk().encode(input)), input);
+	}
+}
+
+TEST(base58, VeryLongValues) {
+	// Every split of a 64 KB value, Barrett and divmod alike, against long
+	// division by 58^10, ten digits at a time.
+	static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+	std::string data;
+	unsigned x = 777;
+	for (int i = 0; i < 65536; ++i) {
+		x = x * 1103515245 + 12345;
+		data.push_back(static_cast<char>(x >> 16));
+	}
+	std::string expected;
+	uinteger_t quotient(data.data(), data.size(), 256);
+	uinteger_t chunk(430804206899405824ULL);  // 58^10
+	do {
+		auto r = quotient.divmod(chunk);
+		auto v = static_cast<std::uint64_t>(r.second);
+		quotient = std::move(r.first);
+		for (int i = 0; i < 10 && (v || quotient); ++i) {
+			expected.push_back(alphabet[v % 58]);
+			v /= 58;
+		}
+	} while (quotient);
+	std::reverse(expected.begin(), expected.end());
+
+	auto encoded = Base58::bitcoin().encode(data);
+	EXPECT_EQ(encoded, expected);
+	EXPECT_EQ(Base58::bitcoin().decode(encoded), data);
+}
+
+TEST(base58, ParallelEncode) {
+	// Past 16384 digits the split runs on the pool; the text must not change.
+	std::string data;
+	unsigned x = 54321;
+	for (int i = 0; i < 12500; ++i) {
+		x = x * 1103515245 + 12345;
+		data.push_back(static_cast<char>(x >> 16));
+	}
+	auto expected = Base58::bitcoinchk().encode(data);
+	for (std::size_t threads : {1, 2, 4}) {
+		BaseX::workers pool(threads);
+		EXPECT_EQ(pool.size(), threads);
+		EXPECT_EQ(Base58::bitcoinchk().encode(data, pool), expected);
+		EXPECT_EQ(Base58::bitcoinchk().encode(uinteger_t(data.data(), data.size(), 256), pool), expected);
+		EXPECT_EQ(Base58::bitcoinchk().encode("hello world", pool), Base58::bitcoinchk().encode("hello world"));
+	}
+}
+
+TEST(base58, BulkDecode) {
+	// Tokens of uneven lengths, every tenth one bad, over several pieces.
+	std::string tokens;
+	std::vector<std::string> expected;
+	unsigned x = 777;
+	for (int i = 0; i < 5000; ++i) {
+		std::string value;
+		for (int n = i % 40 + 1; n; --n) {
+			x = x * 1103515245 + 12345;
+			value.push_back(static_cast<char>(x >> 16));
+		}
+		auto token = Base58::bitcoinchk().encode(value);
+		if (i % 10 == 3) {
+			token[1] = '0';
+			expected.emplace_back();
+		} else {
+			expected.push_back(Base58::bitcoinchk().decode(token));
+		}
+		tokens += token;
+		tokens += '\n';
+	}
+	auto check = [&](const BaseX::bulk& result) {
+		ASSERT_EQ(result.errors.size(), expected.size());
+		ASSERT_EQ(result.offsets.size(), expected.size() + 1);
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			EXPECT_EQ(result.bytes.substr(result.offsets[i], result.offsets[i + 1] - result.offsets[i]), expected[i]);
+			if (i % 10 == 3) {
+				EXPECT_EQ(result.errors[i].code, BaseX::errc::invalid_character);
+				EXPECT_EQ(result.errors[i].offset, 1u);
+			} else {
+				EXPECT_TRUE(result.errors[i]);
+			}
+		}
+	};
+	check(Base58::bitcoinchk().decode_bulk(tokens));
+	for (std::size_t threads : {1, 2, 4}) {
+		BaseX::workers pool(threads);
+		check(Base58::bitcoinchk().decode_bulk(tokens, '\n', pool));
+	}
+
+	// Only a trailing delimiter is dropped; empty tokens between are kept.
+	auto result = Base58::bitcoin().decode_bulk("2g,,3mJr0,", ',');
+	ASSERT_EQ(result.errors.size(), 3u);
+	EXPECT_EQ(result.bytes.substr(0, result.offsets[1]), "a");
+	EXPECT_EQ(result.errors[2].code, BaseX::errc::invalid_character);
+	EXPECT_EQ(Base58::bitcoin().decode_bulk("").errors.size(), 0u);
+}
+
+TEST(base58, WordBoundaries) {
+	// 58^10 is the largest power of 58 that fits in a 64-bit digit; digits are
+	// extracted ten at a time, so check both sides of the word boundary.
+	uinteger_t p10 = 430804206899405824ULL;  // 58^10
+	EXPECT_EQ(Base58::bitcoin().encode(p10 - 1), "zzzzzzzzzz");
+	EXPECT_EQ(Base58::bitcoin().encode(p10), "21111111111");
+	EXPECT_EQ(Base58::bitcoin().encode(p10 * p10), "211111111111111111111");
+	EXPECT_EQ(Base58::bitcoin().encode(p10 * p10 - 1), "zzzzzzzzzzzzzzzzzzzz");
+	EXPECT_EQ(Base58::bitcoin().decode<uinteger_t>("zzzzzzzzzz"), p10 - 1);
+	EXPECT_EQ(Base58::bitcoin().decode<uinteger_t>("21111111111"), p10);
+	EXPECT_EQ(Base58::bitcoin().decode<uinteger_t>("211111111111111111111"), p10 * p10);
+	EXPECT_EQ(Base58::bitcoin().decode<uinteger_t>("zzzzzzzzzzzzzzzzzzzz"), p10 * p10 - 1);
+}
+
+TEST(base16, LongValues) {
+	std::string data;
+	for (int i = 0; i < 100000; ++i) {
+		data.push_back(static_cast<char>(i * 7 + 0x41));
+	}
+	auto encoded = Base16::base16().encode(data);
+	EXPECT_EQ(encoded.size(), data.size() * 2);
+	EXPECT_EQ(Base16::base16().decode(encoded), data);
+	EXPECT_EQ(Base64::base64().decode(Base64::base64().encode(data)), data);
+
+	// The first bad character is reported even though digits are packed from
+	// the end of the input.
+	encoded[10] = 'x';
+	encoded[20] = 'y';
+	try {
+		Base16::base16().decode(encoded);
+		FAIL();
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid character: 'x' at 10");
+	}
+}
+
+TEST(rfc4648, Vectors) {
+	// RFC 4648, section 10.
+	EXPECT_EQ(Base64::rfc4648().encode(""), "");
+	EXPECT_EQ(Base64::rfc4648().encode("f"), "Zg==");
+	EXPECT_EQ(Base64::rfc4648().encode("fo"), "Zm8=");
+	EXPECT_EQ(Base64::rfc4648().encode("foo"), "Zm9v");
+	EXPECT_EQ(Base64::rfc4648().encode("foob"), "Zm9vYg==");
+	EXPECT_EQ(Base64::rfc4648().encode("fooba"), "Zm9vYmE=");
+	EXPECT_EQ(Base64::rfc4648().encode("foobar"), "Zm9vYmFy");
+	EXPECT_EQ(Base64::rfc4648().decode(""), "");
+	EXPECT_EQ(Base64::rfc4648().decode("Zg=="), "f");
+	EXPECT_EQ(Base64::rfc4648().decode("Zm8="), "fo");
+	EXPECT_EQ(Base64::rfc4648().decode("Zm9vYmFy"), "foobar");
+
+	EXPECT_EQ(Base32::rfc4648().encode("f"), "MY======");
+	EXPECT_EQ(Base32::rfc4648().encode("fo"), "MZXQ====");
+	EXPECT_EQ(Base32::rfc4648().encode("foo"), "MZXW6===");
+	EXPECT_EQ(Base32::rfc4648().encode("foob"), "MZXW6YQ=");
+	EXPECT_EQ(Base32::rfc4648().encode("fooba"), "MZXW6YTB");
+	EXPECT_EQ(Base32::rfc4648().encode("foobar"), "MZXW6YTBOI======");
+	EXPECT_EQ(Base32::rfc4648().decode("MZXW6YTBOI======"), "foobar");
+
+	EXPECT_EQ(Base32::rfc4648hex().encode("f"), "CO======");
+	EXPECT_EQ(Base32::rfc4648hex().encode("foobar"), "CPNMUOJ1E8======");
+	EXPECT_EQ(Base32::rfc4648hex().decode("CPNMUOJ1E8======"), "foobar");
+
+	EXPECT_EQ(Base64::rfc4648url_unpadded().encode("fooba"), "Zm9vYmE");
+	EXPECT_EQ(Base64::rfc4648url_unpadded().decode("Zm9vYmE"), "fooba");
+
+	// Block padding alphabets are byte-aligned: leading zero bytes and long
+	// inputs are kept as-is.
+	EXPECT_EQ(Base64::rfc4648().encode(std::string("\0\0\1", 3)), "AAAB");
+	EXPECT_EQ(Base64::rfc4648().decode("AAAB"), std::string("\0\0\1", 3));
+	EXPECT_EQ(Base64::rfc4648().encode("\x03\xe0"), "A+A=");
+	std::string data(100, '\xff');
+	auto encoded = Base64::rfc4648url().encode(data);
+	EXPECT_EQ(encoded, std::string(132, '_') + "_w==");
+	EXPECT_EQ(Base64::rfc4648url().decode(encoded), data);
+}
+
+TEST(rfc4648, Streaming) {
+	std::string data;
+	for (int i = 0; i < 1000; ++i) {
+		data.push_back(static_cast<char>(i * 31 + 7));
+	}
+	for (auto base : {&Base32::rfc4648(), &Base64::rfc4648(), &Base64::rfc4648url_unpadded()}) {
+		BaseX::encoder encoder(*base);
+		std::string encoded;
+		for (std::size_t i = 0; i < data.size(); i += 7) {
+			encoder.update(encoded, data.data() + i, std::min<std::size_t>(7, data.size() - i));
+		}
+		encoder.finish(encoded);
+		EXPECT_EQ(encoded, base->encode(data));
+
+		BaseX::decoder decoder(*base);
+		std::string decoded;
+		for (std::size_t i = 0; i < encoded.size(); i += 5) {
+			decoder.update(decoded, encoded.data() + i, std::min<std::size_t>(5, encoded.size() - i));
+		}
+		decoder.finish(decoded);
+		EXPECT_EQ(decoded, data);
+	}
+
+	BaseX::decoder decoder(Base64::rfc4648());
+	std::string decoded;
+	decoder.update(decoded, "Zm9v");
+	try {
+		decoder.update(decoded, "Y!==");
+		FAIL() << "expected std::invalid_argument";
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid character: '!' at 5");
+	}
+
+	EXPECT_THROW(BaseX::encoder(Base58::bitcoin()), std::invalid_argument);
+	EXPECT_THROW(BaseX::decoder(Base64::base64()), std::invalid_argument);
+}
+
+TEST(rfc4648, LongInputs) {
+	// Long enough for every vector width, with a tail left to the scalar loop.
+	std::string data;
+	for (int i = 0; i < 1000; ++i) {
+		data.push_back(static_cast<char>(i * 131 + 17));
+	}
+	auto base64 = Base64::rfc4648().encode(data);
+	EXPECT_EQ(base64.size(), 1336u);
+	EXPECT_EQ(base64.substr(0, 16), "EZQXmh2gI6YprC+y");
+	EXPECT_EQ(Base64::rfc4648().decode(base64), data);
+	auto base32 = Base32::rfc4648().encode(data);
+	EXPECT_EQ(base32.size(), 1600u);
+	EXPECT_EQ(base32.substr(0, 16), "CGKBPGQ5UAR2MKNM");
+	EXPECT_EQ(Base32::rfc4648().decode(base32), data);
+
+	std::string wrapped;
+	for (std::size_t i = 0; i < base64.size(); i += 76) {
+		wrapped += base64.substr(i, 76) + "\r\n";
+	}
+	EXPECT_EQ(Base64::rfc4648().decode(wrapped), data);
+
+	base64[700] = '.';
+	try {
+		Base64::rfc4648().decode(base64);
+		FAIL() << "expected std::invalid_argument";
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid character: '.' at 700");
+	}
+}
+
+TEST(simd, Levels) {
+	std::string data;
+	for (int i = 0; i < 3000; ++i) {
+		data.push_back(static_cast<char>(i * 131 + 17));
+	}
+	auto base64 = Base64::rfc4648().encode(data);
+	auto base32 = Base32::rfc4648().encode(data);
+	auto base16 = Base16::base16().encode(data);
+	auto base58 = Base58::bitcoin().encode(data);
+	auto bad = base58;
+	bad[1000] = '0';
+
+	auto saved = base_x_simd::get_level();
+	for (auto level : {base_x_simd::level::scalar, base_x_simd::level::sse41, base_x_simd::level::avx2, base_x_simd::level::avx512vbmi}) {
+		EXPECT_LE(base_x_simd::set_level(level), level);
+		EXPECT_EQ(Base64::rfc4648().encode(data), base64);
+		EXPECT_EQ(Base64::rfc4648().decode(base64), data);
+		EXPECT_EQ(Base32::rfc4648().encode(data), base32);
+		EXPECT_EQ(Base32::rfc4648().decode(base32), data);
+		EXPECT_EQ(Base16::base16().encode(data), base16);
+		EXPECT_EQ(Base16::base16().decode(base16), data);
+		EXPECT_EQ(Base58::bitcoin().decode(base58), data);
+		EXPECT_TRUE(Base58::bitcoin().is_valid(base58));
+		EXPECT_FALSE(Base58::bitcoin().is_valid(bad));
+		try {
+			Base58::bitcoin().decode(bad);
+			FAIL() << "expected std::invalid_argument";
+		} catch (const std::invalid_argument& e) {
+			EXPECT_STREQ(e.what(), "Error: Invalid character: '0' at 1000");
+		}
+	}
+	base_x_simd::set_level(saved);
+
+	// What BASE_X_SIMD does to the level picked at startup.
+	auto best = base_x_simd::level::avx512vbmi;
+	EXPECT_EQ(base_x_simd::capped(best, nullptr), best);
+	EXPECT_EQ(base_x_simd::capped(best, ""), best);
+	EXPECT_EQ(base_x_simd::capped(best, "avx2"), base_x_simd::level::avx2);
+	EXPECT_EQ(base_x_simd::capped(best, "sse4.1"), base_x_simd::level::sse41);
+	EXPECT_EQ(base_x_simd::capped(best, "scalar"), base_x_simd::level::scalar);
+	EXPECT_EQ(base_x_simd::capped(base_x_simd::level::sse41, "avx512vbmi"), base_x_simd::level::sse41);
+	EXPECT_EQ(base_x_simd::capped(best, "avx-2"), base_x_simd::level::scalar);
+	EXPECT_EQ(base_x_simd::capped(best, "AVX2"), base_x_simd::level::scalar);
+}
+
+TEST(simd, Checksums) {
+	std::string data;
+	for (int i = 0; i < 3000; ++i) {
+		data.push_back(static_cast<char>(i * 131 + 17));
+	}
+	auto base16 = Base16::base16chk().encode(data);
+	for (std::size_t i = 0; i < base16.size(); i += 3) {
+		if (base16[i] >= 'a') base16[i] = static_cast<char>(base16[i] - 'a' + 'A');
+	}
+	// '~' is ignored, and '1', 'I' and '0' translate to 'l', 'l' and 'O'.
+	auto dubalu = Base59::dubaluchk().encode(data);
+	std::string mangled;
+	for (std::size_t i = 0; i < dubalu.size(); ++i) {
+		mangled += dubalu[i] == 'l' ? (i % 2 ? '1' : 'I') : dubalu[i] == 'O' ? '0' : dubalu[i];
+		if (i % 100 == 99) mangled += '~';
+	}
+	auto bad = mangled;
+	bad[2000] = bad[2000] == 'z' ? 'G' : 'z';
+
+	auto saved = base_x_simd::get_level();
+	for (auto level : {base_x_simd::level::scalar, base_x_simd::level::sse41, base_x_simd::level::avx2, base_x_simd::level::avx512vbmi}) {
+		EXPECT_LE(base_x_simd::set_level(level), level);
+		EXPECT_TRUE(Base16::base16chk().is_valid(base16));
+		EXPECT_TRUE(Base59::dubaluchk().is_valid(dubalu));
+		EXPECT_TRUE(Base59::dubaluchk().is_valid(mangled));
+		EXPECT_EQ(Base59::dubaluchk().decode(mangled), data);
+		EXPECT_FALSE(Base59::dubaluchk().is_valid(bad));
+		EXPECT_FALSE(Base59::dubaluchk().is_valid(mangled.substr(0, 1500)));
+	}
+	base_x_simd::set_level(saved);
+}
+
+TEST(integers, Native) {
+	EXPECT_EQ(Base32::crockford().decode<int>("FVCK"), 519571);
+	EXPECT_EQ(Base32::crockfordchk().decode<unsigned>("16JD"), 1234u);
+	EXPECT_EQ(Base62::base62().encode(std::uint64_t(0)), "0");
+	EXPECT_EQ(Base62::base62().encode(~std::uint64_t(0)), "LygHa16AHYF");
+	EXPECT_EQ(Base62::base62().decode<std::uint64_t>("LygHa16AHYF"), ~std::uint64_t(0));
+	EXPECT_EQ(Base62::base62().encode(~std::uint64_t(0)), Base62::base62().encode(uinteger_t("ffffffffffffffff", 16)));
+	EXPECT_EQ(Base16::base16().decode<std::uint32_t>("ffffffff"), 0xffffffffu);
+	EXPECT_EQ(Base16::base16().decode<std::int32_t>("7fffffff"), 0x7fffffff);
+
+	// Values that do not fit the result are reported, not truncated.
+	EXPECT_THROW(Base62::base62().decode<std::uint64_t>("LygHa16AHYG"), std::out_of_range);
+	EXPECT_THROW(Base16::base16().decode<std::uint32_t>("100000000"), std::out_of_range);
+	EXPECT_THROW(Base16::base16().decode<std::int32_t>("80000000"), std::out_of_range);
+	EXPECT_THROW(Base62::base62chk().decode<std::uint8_t>(Base62::base62chk().encode(256)), std::out_of_range);
+	EXPECT_THROW(Base62::base62().decode<int>("!"), std::invalid_argument);
+}
+
+TEST(buffers, EncodeTo) {
+	char out[1024];
+	auto uuid = "\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256";
+	EXPECT_EQ(std::string(out, Base62::base62().encode_to(out, sizeof(out), uuid, 16)), "6a630O1jrtMjCrQDyG3D3O");
+	EXPECT_EQ(std::string(out, Base62::base62().encode_to(out, 22, uuid, 16)), "6a630O1jrtMjCrQDyG3D3O");
+	EXPECT_THROW(Base62::base62().encode_to(out, 21, uuid, 16), std::length_error);
+	EXPECT_EQ(std::string(out, Base64::rfc4648().encode_to(out, sizeof(out), "foob")), "Zm9vYg==");
+	EXPECT_THROW(Base64::rfc4648().encode_to(out, 7, "foob"), std::length_error);
+	EXPECT_EQ(std::string(out, Base58::bitcoinchk().encode_to(out, sizeof(out), 1234567)), Base58::bitcoinchk().encode(1234567));
+
+	// max_encoded_size() always leaves enough room.
+	std::string data;
+	for (int i = 0; i < 100; ++i) {
+		data.push_back(static_cast<char>(0xff - i));
+	}
+	for (auto base : {&Base2::base2(), &Base16::base16(), &Base32::crockfordchk(), &Base32::rfc4648(), &Base58::bitcoinchk(), &Base62::base62(), &Base64::base64(), &Base64::rfc4648()}) {
+		for (std::size_t sz : {0, 1, 8, 9, 16, 33, 64, 100}) {
+			auto input = data.substr(0, sz);
+			auto expected = base->encode(input);
+			EXPECT_LE(expected.size(), base->max_encoded_size(sz));
+			EXPECT_EQ(std::string(out, base->encode_to(out, expected.size(), input)), expected);
+		}
+	}
+}
+
+TEST(buffers, DecodeTo) {
+	unsigned char out[1024];
+	auto uuid = "\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256";
+	auto n = Base62::base62().decode_to(out, sizeof(out), "6a630O1jrtMjCrQDyG3D3O");
+	EXPECT_EQ(std::string(reinterpret_cast<char*>(out), n), std::string(uuid, 16));
+	EXPECT_EQ(Base62::base62().decode_to(out, 16, "6a630O1jrtMjCrQDyG3D3O"), 16u);
+	EXPECT_THROW(Base62::base62().decode_to(out, 15, "6a630O1jrtMjCrQDyG3D3O"), std::length_error);
+	n = Base64::rfc4648().decode_to(out, 4, "Zm9vYg==");
+	EXPECT_EQ(std::string(reinterpret_cast<char*>(out), n), "foob");
+	EXPECT_THROW(Base64::rfc4648().decode_to(out, 3, "Zm9vYg=="), std::length_error);
+	n = Base16::base16().decode_to(out, sizeof(out), "000A0B");
+	EXPECT_EQ(std::string(reinterpret_cast<char*>(out), n), "\x0a\x0b");
+	EXPECT_THROW(Base58::bitcoinchk().decode_to(out, sizeof(out), "1234"), std::invalid_argument);
+
+	// max_decoded_size() always leaves enough room.
+	std::string data;
+	for (int i = 0; i < 100; ++i) {
+		data.push_back(static_cast<char>(0xff - i));
+	}
+	for (auto base : {&Base2::base2(), &Base16::base16(), &Base32::crockfordchk(), &Base32::rfc4648(), &Base58::bitcoinchk(), &Base62::base62(), &Base64::base64(), &Base64::rfc4648()}) {
+		for (std::size_t sz : {1, 8, 9, 16, 33, 64, 100}) {
+			auto encoded = base->encode(data.substr(0, sz));
+			auto expected = base->decode(encoded);
+			EXPECT_LE(expected.size(), base->max_decoded_size(encoded.size()));
+			n = base->decode_to(out, expected.size(), encoded);
+			EXPECT_EQ(std::string(reinterpret_cast<char*>(out), n), expected);
+		}
+	}
+}
+
+TEST(buffers, Batch) {
+	// Leading zero bytes, an all-zero record and a full one.
+	std::string records;
+	records.append("\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256", 16);
+	records.append(15, '\0').append(1, '\1');
+	records.append(16, '\0');
+	records.append(16, '\xff');
+	records.append("\0\0\0\0\0\0\0\0\0\0\0\0\0\0\x12\x34", 16);
+	auto bytes = reinterpret_cast<const unsigned char*>(records.data());
+	const std::size_t count = records.size() / 16;
+
+	for (auto base : {&Base62::base62(), &Base58::bitcoinchk(), &Base32::crockfordchk(), &Base64::rfc4648(), &Base16::base16()}) {
+		std::string arena;
+		std::vector<std::size_t> offsets;
+		base->encode_batch(arena, offsets, bytes, 16, count);
+		ASSERT_EQ(offsets.size(), count + 1);
+		auto stride = base->max_encoded_size(16);
+		std::vector<char> fixed(count * stride);
+		std::vector<std::size_t> lengths(count);
+		base->encode_batch(fixed.data(), stride, lengths.data(), bytes, 16, count);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto expected = base->encode(records.substr(i * 16, 16));
+			EXPECT_EQ(arena.substr(offsets[i], offsets[i + 1] - offsets[i]), expected);
+			EXPECT_EQ(std::string(&fixed[i * stride], lengths[i]), expected);
+		}
+
+		std::string back(records.size(), '?');
+		auto out = reinterpret_cast<unsigned char*>(&back[0]);
+		base->decode_batch(out, 16, arena.data(), offsets.data(), count);
+		EXPECT_EQ(back, records);
+		back.assign(records.size(), '?');
+		base->decode_batch(out, 16, fixed.data(), stride, lengths.data(), count);
+		EXPECT_EQ(back, records);
+	}
+
+	char text[32];
+	std::size_t length;
+	EXPECT_THROW(Base62::base62().encode_batch(text, 21, &length, bytes, 16, 1), std::length_error);
+
+	// Errors are decode()'s, plus values too long for the record.
+	unsigned char record[16];
+	std::size_t offsets[] = {0, 22};
+	EXPECT_THROW(Base62::base62().decode_batch(record, 16, "6a630O1jrtMjCrQDyG3D3_", offsets, 1), std::invalid_argument);
+	EXPECT_THROW(Base62::base62().decode_batch(record, 15, "6a630O1jrtMjCrQDyG3D3O", offsets, 1), std::length_error);
+	// Ignored characters take the general path.
+	auto dashed = Base32::crockfordchk().encode(std::string("\x12\x34", 2));
+	dashed.insert(1, "-");
+	std::size_t whole[] = {0, dashed.size()};
+	Base32::crockfordchk().decode_batch(record, 4, dashed.data(), whole, 1);
+	EXPECT_EQ(std::string(reinterpret_cast<char*>(record), 4), std::string("\0\0\x12\x34", 4));
+}
+
+#if defined(BASE_X_PMR)
+TEST(buffers, MemoryResource) {
+	char buffer[1 << 14];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	std::string data(100, '\0');
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<char>(i * 37 + 11);
+	}
+	for (auto base : {&Base58::bitcoinchk(), &Base62::base62(), &Base64::base64(), &Base64::rfc4648()}) {
+		auto text = base->encode(data, &arena);
+		EXPECT_EQ(text.get_allocator().resource(), &arena);
+		EXPECT_EQ(std::string(text), base->encode(data));
+		auto back = base->decode(text, &arena);
+		EXPECT_EQ(std::string(back), data);
+		std::pmr::vector<unsigned char> bytes(&arena);
+		base->decode(bytes, text);
+		EXPECT_EQ(std::string(bytes.begin(), bytes.end()), data);
+	}
+
+	// Values past fixed-width words decode on scratch limbs, with the
+	// statuses of the uinteger_t decode.
+	auto text = Base58::bitcoinchk().encode(data);
+	uinteger_t value;
+	std::pmr::string bytes(&arena);
+	for (auto at : {std::size_t(0), std::size_t(70), text.size() - 1}) {
+		for (char c : {'0', 'z'}) {
+			auto bad = text;
+			bad[at] = bad[at] == c ? '2' : c;
+			auto st = Base58::bitcoinchk().try_decode(bytes, bad);
+			auto expected = Base58::bitcoinchk().try_decode(value, bad);
+			EXPECT_EQ(st.code, expected.code);
+			EXPECT_EQ(st.offset, expected.offset);
+		}
+	}
+}
+#endif
+
+TEST(errors, TryDecode) {
+	std::string out;
+	auto st = Base58::bitcoin().try_decode(out, "3mJr0");
+	EXPECT_FALSE(st);
+	EXPECT_EQ(st.code, BaseX::errc::invalid_character);
+	EXPECT_EQ(st.offset, 4u);
+	EXPECT_TRUE(Base58::bitcoin().try_decode(out, "3mJr7AoUXx2Wqd"));
+	EXPECT_EQ(out, "1234598760");
+
+	// Offsets are indexes into the input, check characters included.
+	auto encoded = Base58::bitcoinchk().encode("hello world");
+	encoded.back() = encoded.back() == '1' ? '2' : '1';
+	st = Base58::bitcoinchk().try_decode(out, encoded);
+	EXPECT_EQ(st.code, BaseX::errc::invalid_checksum);
+	EXPECT_EQ(st.offset, encoded.size() - 1);
+	st = Base58::bitcoinchk().try_decode(out, "3m0Jr");
+	EXPECT_EQ(st.code, BaseX::errc::invalid_character);
+	EXPECT_EQ(st.offset, 2u);
+	encoded = Base32::crockfordchk().encode("hello world");
+	encoded.back() = encoded.back() == '0' ? '1' : '0';
+	EXPECT_EQ(Base32::crockfordchk().try_decode(out, encoded).code, BaseX::errc::invalid_check);
+	EXPECT_EQ(Base64::rfc4648().try_decode(out, "Zm9v!mFy").offset, 4u);
+
+	// Too short for the check characters: nothing past the end is read, so
+	// what follows the text does not matter.
+	std::unique_ptr<char[]> text(new char[1]{'2'});
+	for (auto t : {"", "2"}) {
+		st = Base58::base58chk().try_decode(out, t, 0);
+		EXPECT_EQ(st.code, BaseX::errc::invalid_checksum);
+		EXPECT_EQ(st.offset, 0u);
+	}
+	st = Base58::base58chk().try_decode(out, text.get(), 1);
+	EXPECT_EQ(st.code, BaseX::errc::invalid_checksum);
+	EXPECT_EQ(st.offset, 0u);
+	std::uint64_t value;
+	EXPECT_EQ(Base58::base58chk().try_decode(value, text.get(), 0).code, BaseX::errc::invalid_checksum);
+	EXPECT_EQ(Base32::crockfordchk().try_decode(out, text.get(), 0).code, BaseX::errc::invalid_check);
+	EXPECT_EQ(Base32::crockfordchk().try_decode(value, "", 0).code, BaseX::errc::invalid_check);
+	// The throwing decode quotes no character for them either, so it does
+	// not read encoded[st.offset] at the end of the text.
+	auto none = text.get() + 1;
+	try {
+		Base58::base58chk().decode(none, 0);
+		FAIL();
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid checksum");
+	}
+	try {
+		Base58::base58chk().decode(text.get(), 1);
+		FAIL();
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid checksum");
+	}
+	EXPECT_THROW(Base58::base58chk().decode<std::uint64_t>(none, 0), std::invalid_argument);
+	EXPECT_THROW(Base32::crockfordchk().decode(none, 0), std::invalid_argument);
+
+	// Integers, and the same errors from the throwing decode().
+	unsigned char small;
+	EXPECT_EQ(Base62::base62().try_decode(small, Base62::base62().encode(300)).code, BaseX::errc::out_of_range);
+	uinteger_t num;
+	EXPECT_EQ(Base62::base62().try_decode(num, std::string(100, 'z') + "!").offset, 100u);
+	try {
+		Base58::bitcoinchk().decode("3m0Jr");
+		FAIL();
+	} catch (const std::invalid_argument& e) {
+		EXPECT_STREQ(e.what(), "Error: Invalid character: '0' at 2");
+	}
+
+	std::error_code ec;
+	EXPECT_EQ(Base58::bitcoin().decode("3mJr0", ec), "");
+	EXPECT_EQ(ec, BaseX::errc::invalid_character);
+	EXPECT_STREQ(ec.category().name(), "base_x");
+	EXPECT_EQ(Base58::bitcoin().decode("3mJr7AoUXx2Wqd", ec), "1234598760");
+	EXPECT_FALSE(ec);
+	EXPECT_EQ(Base62::base62().decode<unsigned char>(Base62::base62().encode(300), ec), 0);
+	EXPECT_EQ(ec, BaseX::errc::out_of_range);
+}
+
+TEST(compile_time, Literals) {
+	using namespace base_x_literals;
+	constexpr auto id = 519571_base32;
+	static_assert(id.size() == 4, "519571_base32");
+	EXPECT_EQ(std::string(id.data(), id.size()), Base32::base32().encode(519571));
+	constexpr auto big = 0xffff'ffff'ffff'ffff_base62;
+	EXPECT_EQ(std::string(big.data(), big.size()), Base62::base62().encode(0xffffffffffffffffULL));
+
+	constexpr auto key = Base58::bitcoinchk_encoder.encode<Base58::bitcoinchk_encoder.encoded_length("hello world")>("hello world");
+	EXPECT_EQ(std::string(key.data(), key.size()), Base58::bitcoinchk().encode("hello world"));
+	constexpr auto foobar = Base64::rfc4648_encoder.decode<6>("Zm9vYmFy");
+	EXPECT_EQ(std::string(foobar.data(), foobar.size()), "foobar");
+	static_assert(Base58::bitcoin_encoder.decoded_length("3mJr7AoUXx2Wqd") == 10, "decoded_length");
+	constexpr auto uuid = Base62::base62_encoder.decode<16>("6a630O1jrtMjCrQDyG3D3O");
+	EXPECT_EQ(std::string(uuid.data(), uuid.size()), "\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256");
+
+	// Outside constant expressions errors throw, as decode() does.
+	EXPECT_THROW(Base58::bitcoin_encoder.decode<10>("3mJr0AoUXx2Wqd"), std::invalid_argument);
+	EXPECT_THROW(Base58::bitcoin_encoder.decode<9>("3mJr7AoUXx2Wqd"), std::length_error);
+}
+
+struct dubalu_alphabet : BaseXAlphabet {
+	static constexpr char alphabet[] = "zGLUAC2EwdDRrkWBatmscxyYlg6jhP7K53TibenZpMVuvoO9H4XSQq8FfJN";
+	static constexpr char translate[] = "~l1IO0";
+};
+
+TEST(BasicBaseX, MatchesBaseX) {
+	static_assert(std::is_base_of<BaseX, std::decay_t<decltype(Base58::bitcoin_encoder)>>::value, "presets are BasicBaseX");
+	constexpr BasicBaseX<dubalu_alphabet, BaseX::with_checksum> fixed;
+	const BaseX dynamic{BaseX::with_checksum, "zGLUAC2EwdDRrkWBatmscxyYlg6jhP7K53TibenZpMVuvoO9H4XSQq8FfJN", "", "", "~l1IO0"};
+	EXPECT_EQ(fixed.encode(0xffffffffffffffffULL), dynamic.encode(0xffffffffffffffffULL));
+	EXPECT_EQ(fixed.encode("hello world"), dynamic.encode("hello world"));
+	EXPECT_EQ(fixed.encode("\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256"), Base59::dubaluchk().encode("\330\105\140\310\23\117\21\346\241\342\64\66\73\322\155\256"));
+	EXPECT_EQ(fixed.decode<std::uint64_t>(dynamic.encode(519571)), 519571u);
+	EXPECT_EQ(fixed.decode(dynamic.encode("hello world")), "hello world");
+
+	// Errors and their offsets are the same on both paths.
+	const BaseX& base = fixed;
+	auto text = dynamic.encode(1234567890);
+	text[2] = '~';
+	std::uint64_t value;
+	auto st = base.try_decode(value, text);
+	EXPECT_EQ(st.code, BaseX::errc::invalid_checksum);
+	EXPECT_EQ(st.code, dynamic.try_decode(value, text).code);
+	text[2] = '#';
+	st = base.try_decode(value, text);
+	EXPECT_EQ(st.code, BaseX::errc::invalid_character);
+	EXPECT_EQ(st.offset, 2u);
+}